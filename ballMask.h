@@ -0,0 +1,50 @@
+#ifndef BALL_MASK_H
+#define BALL_MASK_H
+
+#include <cstdint>
+
+// Set of ball numbers 1..MaxBall stored as a bitmask, bit n = ball n.
+// Jersey Cash 5 (1..45) fits in one 64-bit word; Powerball (1..69) and
+// MegaMillions (1..70) use two.
+template<int MaxBall>
+struct BallMask
+{
+    static const int WORDS = MaxBall / 64 + 1;
+    uint64_t words[WORDS];
+
+    void clear(){
+        for(int w=0; w<WORDS; w++)
+            words[w] = 0;
+    }
+
+    void set(int ball){
+        words[ball >> 6] |= (uint64_t)1 << (ball & 63);
+    }
+
+    bool test(int ball) const{
+        return (words[ball >> 6] >> (ball & 63)) & 1;
+    }
+};
+
+// Number of balls in both sets: popcount of the AND, no branches
+template<int MaxBall>
+inline int countMatches(const BallMask<MaxBall> &a, const BallMask<MaxBall> &b){
+    int matches = 0;
+    for(int w=0; w<BallMask<MaxBall>::WORDS; w++)
+        matches += __builtin_popcountll(a.words[w] & b.words[w]);
+    return matches;
+}
+
+// Call f(ball) for each ball in the set, in ascending order
+template<int MaxBall, class Function>
+inline void forEachBall(const BallMask<MaxBall> &mask, Function f){
+    for(int w=0; w<BallMask<MaxBall>::WORDS; w++){
+        uint64_t bits = mask.words[w];
+        while(bits){
+            f(w * 64 + __builtin_ctzll(bits));
+            bits &= bits - 1;
+        }
+    }
+}
+
+#endif
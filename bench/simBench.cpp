@@ -0,0 +1,389 @@
+// Microbenchmarks for the simulator kernels, per game. Prints one CSV row per
+// kernel: game, kernel, operations, ns per operation and, for kernels that
+// handle tickets, tickets per second. Each row is the best of --repeat runs.
+// The inverted index is also checked against the block kernel; the exit
+// status is 1 if they disagree.
+//
+//   g++ -std=c++17 -O2 -pthread bench/simBench.cpp -o simBench -lcurl `pkg-config libxml-2.0 --cflags --libs`
+//   ./simBench --tickets 4000000 --fixtures bench/fixtures > bench.csv
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "../lotteryEngine.h"
+
+struct BenchOptions
+{
+    long long tickets = 4000000;            // Operations per ticket kernel
+    long long textOps = 1000000;            // Operations per text kernel
+    long long pages = 2000;                 // Fixture pages parsed per extraction run
+    int repeat = 3;                         // Runs per kernel; the fastest is reported
+    std::string fixtures = "bench/fixtures";
+    std::string game;                       // Only this game (cache name); empty = all
+};
+
+// Defeats dead-code elimination of benchmarked results
+static volatile long long sink;
+
+// Fastest of repeat runs of body, in seconds
+template<class Body>
+double bestTime(int repeat, Body body){
+    double best = 0.0;
+    for(int r=0; r<repeat; r++){
+        auto start = std::chrono::steady_clock::now();
+        body();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        if(r == 0 || seconds < best)
+            best = seconds;
+    }
+    return best;
+}
+
+static void report(const char* game, const char* kernel, long long ops, double seconds, long long tickets){
+    std::printf("%s,%s,%lld,%.3f,", game, kernel, ops, seconds * 1e9 / ops);
+    if(tickets > 0)
+        std::printf("%.0f", tickets / seconds);
+    std::printf("\n");
+}
+
+static bool readFile(const std::string &path, std::string &text){
+    std::ifstream in(path.c_str(), std::ios::binary);
+    if(!in)
+        return false;
+    std::ostringstream contents;
+    contents << in.rdbuf();
+    text = contents.str();
+    return true;
+}
+
+template<class Game>
+std::vector<Ticket<Game> > randomPool(size_t count, unsigned long long seed){
+    WhiteBallSampler<Game> sampler;
+    std::vector<Ticket<Game> > pool(count);
+    for(size_t i=0; i<pool.size(); i++)
+        generateTicket(pool[i], sampler, seed, STREAM_TICKET, 1, (long long)i);
+    return pool;
+}
+
+// Rewrite each ticket to hold ball, replacing its lowest number if need be
+template<class Game>
+void shareBall(Ticket<Game> &ticket, int ball){
+    if(ticket.white.test(ball))
+        return;
+    int lowest = 0;
+    forEachBall(ticket.white, [&](int b){ if(lowest == 0) lowest = b; });
+    ticket.white.words[lowest >> 6] &= ~((uint64_t)1 << (lowest & 63));
+    ticket.white.set(ball);
+}
+
+// Check that the inverted index counts exactly the hits the block kernel
+// counts, on pool and on a pool whose tickets (and draws) all share one
+// white number and the bonus ball, where every posting of that number lands
+// on a ticket already listed
+template<class Game>
+bool checkIndex(const std::vector<Ticket<Game> > &pool, const std::vector<Draw<Game> > &draws){
+    std::vector<Ticket<Game> > shared(70000);
+    std::vector<Draw<Game> > shared_draws(draws);
+    WhiteBallSampler<Game> sampler;
+    for(size_t i=0; i<shared.size(); i++){
+        generateTicket(shared[i], sampler, 4, STREAM_TICKET, 1, (long long)i);
+        shareBall(shared[i], 7);
+        shared[i].bonus = Game::bonusPool > 0 ? 1 : 0;
+    }
+    for(size_t d=0; d<shared_draws.size(); d++){
+        shareBall(shared_draws[d].winning, 7);
+        shared_draws[d].winning.bonus = shared[0].bonus;
+    }
+
+    for(int p=0; p<2; p++){
+        const std::vector<Ticket<Game> > &tickets = p == 0 ? pool : shared;
+        const std::vector<Draw<Game> > &scored = p == 0 ? draws : shared_draws;
+        MultiDrawTally block;
+        block.draws.assign(scored.size(), SimTally());
+        for(size_t i=0; i<tickets.size(); i+=TICKET_BLOCK)
+            scoreTickets(&tickets[i], (int)std::min<size_t>(TICKET_BLOCK, tickets.size() - i), scored, block);
+
+        TicketIndex<Game::whitePool, Game::bonusPool> index;
+        index.build(tickets.data(), (uint32_t)tickets.size());
+        for(size_t d=0; d<scored.size(); d++){
+            SimTally tally;
+            index.score(scored[d].winning.white, scored[d].winning.bonus, tally);
+            for(int white=0; white<=Game::picks; white++)
+                for(int bonus=0; bonus<2; bonus++)
+                    if(tally.hits[white][bonus] != block.draws[d].hits[white][bonus]){
+                        std::cerr << "simBench: " << Game::cacheName << ": index and block kernel disagree on "
+                                  << (p == 0 ? "the random pool" : "the shared-number pool") << std::endl;
+                        return false;
+                    }
+        }
+    }
+    return true;
+}
+
+template<class Game>
+bool benchGame(const BenchOptions &options){
+    const char* game = Game::cacheName;
+    const long long n = options.tickets;
+    PhiloxStream gen(1, STREAM_DRAW, 0, 0);
+    WhiteBallSampler<Game> sampler;
+
+    // Ticket generation: quick picks, and winning numbers with a multiplier,
+    // each from its own counter-based stream as in batch runs
+    Ticket<Game> block[TICKET_BLOCK];
+    double seconds = bestTime(options.repeat, [&](){
+        long long check = 0;
+        for(long long i=0; i<n; i++){
+            generateTicket(block[i & (TICKET_BLOCK - 1)], sampler, 1, STREAM_TICKET, 1, i);
+            check += block[i & (TICKET_BLOCK - 1)].bonus;
+        }
+        sink = check;
+    });
+    report(game, "quick_pick", n, seconds, n);
+
+    // The same tickets a block at a time, eight per AVX2 lane set when available
+    seconds = bestTime(options.repeat, [&](){
+        long long check = 0;
+        for(long long i=0; i<n; i+=TICKET_BLOCK){
+            int count = (int)std::min<long long>(TICKET_BLOCK, n - i);
+            generateQuickPicks(block, count, sampler, 1, 1, i);
+            check += block[0].bonus;
+        }
+        sink = check;
+    });
+    report(game, "quick_pick_batch", n, seconds, n);
+
+    seconds = bestTime(options.repeat, [&](){
+        long long check = 0;
+        for(long long i=0; i<n; i++){
+            Ticket<Game> winning;
+            generateTicket(winning, sampler, 1, STREAM_DRAW, 1, i);
+            check += winning.bonus + drawMultiplier<Game>(1, 1, i);
+        }
+        sink = check;
+    });
+    report(game, "winning_numbers", n, seconds, n);
+
+    // Scoring against one draw, cycling through a cache-resident pool
+    const size_t POOL = 1 << 16;
+    std::vector<Ticket<Game> > pool = randomPool<Game>(POOL, 2);
+    Ticket<Game> winning;
+    generateTicket(winning, sampler, gen);
+    const PrizeTable<Game> prizes(100000000, 1);
+
+    seconds = bestTime(options.repeat, [&](){
+        long long check = 0;
+        for(long long i=0; i<n; i++){
+            const Ticket<Game> &ticket = pool[i & (POOL - 1)];
+            check += countMatches(ticket.white, winning.white) + matchesBonus(ticket, winning);
+        }
+        sink = check;
+    });
+    report(game, "match_count", n, seconds, n);
+
+    seconds = bestTime(options.repeat, [&](){
+        Money check = 0;
+        for(long long i=0; i<n; i++){
+            const Ticket<Game> &ticket = pool[i & (POOL - 1)];
+            check += prizes(countMatches(ticket.white, winning.white), matchesBonus(ticket, winning));
+        }
+        sink = check;
+    });
+    report(game, "prize_lookup", n, seconds, n);
+
+    // The batch kernels at production size: a pool of n tickets scored
+    // block by block against 16 draws, and through the inverted index
+    const int DRAWS = 16;
+    std::vector<Draw<Game> > draws;
+    for(int d=0; d<DRAWS; d++){
+        generateTicket(winning, sampler, gen);
+        draws.push_back(Draw<Game>{winning, 1, false, prizes});
+    }
+    pool = randomPool<Game>((size_t)n, 3);
+    seconds = bestTime(options.repeat, [&](){
+        MultiDrawTally tally;
+        tally.draws.assign(draws.size(), SimTally());
+        for(long long i=0; i<n; i+=TICKET_BLOCK)
+            scoreTickets(&pool[i], (int)std::min<long long>(TICKET_BLOCK, n - i), draws, tally);
+        sink = tally.draws[0].hits[0][0];
+    });
+    report(game, "score_block", n * DRAWS, seconds, n * DRAWS);
+
+    TicketIndex<Game::whitePool, Game::bonusPool> index;
+    seconds = bestTime(options.repeat, [&](){
+        index.build(pool.data(), (uint32_t)n);
+    });
+    report(game, "index_build", n, seconds, n);
+
+    seconds = bestTime(options.repeat, [&](){
+        SimTally tally;
+        for(int d=0; d<DRAWS; d++)
+            index.score(draws[d].winning.white, draws[d].winning.bonus, tally);
+        sink = tally.hits[0][0];
+    });
+    report(game, "score_index", n * DRAWS, seconds, n * DRAWS);
+    bool correct = checkIndex(pool, draws);
+    std::vector<Ticket<Game> >().swap(pool);
+
+    // Game data: extracting the fixture page and reading its jackpot
+    std::string page;
+    std::string path = options.fixtures + "/" + game + ".html";
+    if(!readFile(path, page)){
+        std::cerr << "simBench: cannot read " << path << "; skipping extraction" << std::endl;
+        return correct;
+    }
+    std::string jackpot_text;
+    seconds = bestTime(options.repeat, [&](){
+        for(long long i=0; i<options.pages; i++){
+            GameDataExtractor extractor;
+            extractor.feed(page.data(), page.size());
+            extractor.finish();
+            if(i == 0)
+                jackpot_text = extractor.gameData().currentJackpot;
+        }
+    });
+    report(game, "extract_html", options.pages, seconds, 0);
+    if(jackpot_text.empty())
+        std::cerr << "simBench: no jackpot found in " << path << std::endl;
+
+    // A full-size page: the fixture with its results section repeated to
+    // FULL_PAGE_BYTES, fed in curl-sized chunks. The extractor stops after
+    // the draw card; a document parse reads the whole page.
+    const size_t FULL_PAGE_BYTES = 512 * 1024;
+    const size_t CHUNK_BYTES = 16 * 1024;
+    size_t results = page.find("<section class=\"c-results\">");
+    size_t main_end = page.find("</main>");
+    if(results != std::string::npos && main_end != std::string::npos && results < main_end){
+        std::string section = page.substr(results, main_end - results);
+        std::string full = page.substr(0, main_end);
+        while(full.size() + (page.size() - main_end) < FULL_PAGE_BYTES)
+            full += section;
+        full += page.substr(main_end);
+
+        const long long full_pages = std::max(1LL, options.pages / 20);
+        size_t fed = 0;
+        seconds = bestTime(options.repeat, [&](){
+            for(long long i=0; i<full_pages; i++){
+                GameDataExtractor extractor;
+                size_t offset = 0;
+                while(offset < full.size()){
+                    size_t size = std::min(CHUNK_BYTES, full.size() - offset);
+                    offset += size;
+                    if(!extractor.feed(full.data() + offset - size, size))
+                        break;
+                }
+                fed = offset;
+            }
+        });
+        report(game, "extract_full_page", full_pages, seconds, 0);
+
+        seconds = bestTime(options.repeat, [&](){
+            for(long long i=0; i<full_pages; i++){
+                htmlDocPtr doc = htmlReadMemory(full.data(), (int)full.size(), nullptr, nullptr,
+                                                HTML_PARSE_NOERROR | HTML_PARSE_NOWARNING | HTML_PARSE_NONET);
+                sink = doc != nullptr;
+                xmlFreeDoc(doc);
+            }
+        });
+        report(game, "parse_full_page", full_pages, seconds, 0);
+        std::cerr << "simBench: " << game << ": full page of " << formatWithCommas((long long)full.size())
+                  << " bytes, extraction stopped after " << formatWithCommas((long long)fed) << std::endl;
+    }
+
+    seconds = bestTime(options.repeat, [&](){
+        Money check = 0;
+        for(long long i=0; i<options.textOps; i++)
+            check += jackpotFromString(jackpot_text, Game::jackpotUnit);
+        sink = check;
+    });
+    report(game, "jackpot_parse", options.textOps, seconds, 0);
+    return correct;
+}
+
+// Text helpers that do not depend on the game
+void benchText(const BenchOptions &options){
+    const long long n = options.textOps;
+    double seconds = bestTime(options.repeat, [&](){
+        long long check = 0;
+        for(long long i=0; i<n; i++)
+            check += formatWithCommas(i * 7919).size();
+        sink = check;
+    });
+    report("all", "format_commas", n, seconds, 0);
+
+    seconds = bestTime(options.repeat, [&](){
+        long long check = 0;
+        for(long long i=0; i<n; i++){
+            std::string text = "\n\t  Mon, Oct 19, 2026\t\n  ";
+            removeLeadingTrailingSpaces(text);
+            check += text.size();
+        }
+        sink = check;
+    });
+    report("all", "trim_spaces", n, seconds, 0);
+}
+
+static void printBenchUsage(const char* program){
+    std::cout << "Usage: " << program << " [options]\n\n"
+        "  --tickets N      Tickets per ticket kernel and scored pool size (default 4000000)\n"
+        "  --text-ops N     Calls per text kernel (default 1000000)\n"
+        "  --pages N        Fixture pages parsed per extraction run (default 2000)\n"
+        "  --repeat N       Runs per kernel, reporting the fastest (default 3)\n"
+        "  --fixtures DIR   Directory of <game>.html fixture pages (default bench/fixtures)\n"
+        "  --game NAME      Only powerball, mega-millions or jersey-cash-5\n" << std::endl;
+}
+
+int main(int argc, char* argv[]){
+    BenchOptions options;
+
+    for(int i=1; i<argc; i++){
+        std::string arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        long long number;
+
+        if(arg == "--help" || arg == "-h"){
+            printBenchUsage(argv[0]);
+            return 0;
+        }
+        else if((arg == "--tickets" || arg == "--text-ops" || arg == "--pages" || arg == "--repeat")
+                && parseCount(value, number) && number >= 1 && number <= (1LL << 31)){
+            if(arg == "--tickets")
+                options.tickets = number;
+            else if(arg == "--text-ops")
+                options.textOps = number;
+            else if(arg == "--pages")
+                options.pages = number;
+            else
+                options.repeat = (int)number;
+            i++;
+        }
+        else if(arg == "--fixtures" && value != nullptr){
+            options.fixtures = value;
+            i++;
+        }
+        else if(arg == "--game" && value != nullptr){
+            options.game = value;
+            i++;
+        }
+        else{
+            std::cerr << "Invalid option or value: " << arg << "\n" << std::endl;
+            printBenchUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    std::printf("game,kernel,ops,ns_per_op,tickets_per_sec\n");
+    bool correct = true;
+    if(options.game.empty() || options.game == PowerballGame::cacheName)
+        correct &= benchGame<PowerballGame>(options);
+    if(options.game.empty() || options.game == MegaMillionsGame::cacheName)
+        correct &= benchGame<MegaMillionsGame>(options);
+    if(options.game.empty() || options.game == JerseyCash5Game::cacheName)
+        correct &= benchGame<JerseyCash5Game>(options);
+    if(options.game.empty())
+        benchText(options);
+    return correct ? 0 : 1;
+}
@@ -0,0 +1,19 @@
+#ifndef CPU_FEATURES_H
+#define CPU_FEATURES_H
+
+// SIMD_AVX2 is defined where AVX2 kernels can be compiled (GCC or Clang on
+// x86): they are built with a target attribute, so the program itself needs
+// no -mavx2 and still runs on older CPUs. Call a kernel only when
+// cpuHasAvx2() says the running CPU has the instructions.
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define SIMD_AVX2 1
+#include <immintrin.h>
+
+// Checked once; the CPU cannot change under a running program
+inline bool cpuHasAvx2(){
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+}
+#endif
+
+#endif
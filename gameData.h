@@ -0,0 +1,332 @@
+#ifndef GAME_DATA_H
+#define GAME_DATA_H
+
+#include <iostream>
+#include <random>
+#include <string>
+#include <memory>
+#include <vector>
+#include <cstring>
+#include <curl/curl.h>
+#include <libxml/HTMLparser.h>
+#include <unistd.h>
+
+struct GameDataStruct
+{
+    std::string nextDrawDate;
+    std::string currentJackpot;
+};
+
+// Streaming extractor for a lotteryusa.com game page. The page is pushed
+// through a libxml2 SAX parser as it arrives, capturing the text of the first
+// element whose class contains c-next-draw-card__prize-value (the jackpot) and
+// of the first containing c-next-draw-card__date (the next draw date). Once
+// both are complete the rest of the page is not needed, so no document tree is
+// built and the transfer can stop early.
+class GameDataExtractor
+{
+public:
+    GameDataExtractor() : parser(nullptr), field(NONE), depth(0), started(false), html(false),
+                          foundJackpot(false), foundDate(false){
+        std::memset(&handler, 0, sizeof(handler));
+        handler.startElement = startElement;
+        handler.endElement = endElement;
+        handler.characters = characters;
+        handler.ignorableWhitespace = characters;
+        parser = htmlCreatePushParserCtxt(&handler, this, nullptr, 0, nullptr, XML_CHAR_ENCODING_NONE);
+        if (parser != nullptr)
+            htmlCtxtUseOptions(parser, HTML_PARSE_NOERROR | HTML_PARSE_NOWARNING | HTML_PARSE_NONET);
+    }
+
+    ~GameDataExtractor(){
+        if (parser != nullptr)
+            htmlFreeParserCtxt(parser);
+    }
+
+    // Parse the next piece of the page. Returns false when no more input is
+    // wanted: both fields are found, or the page is not HTML.
+    bool feed(const char* data, size_t size){
+        if (!started) {
+            size_t first = 0;
+            while (first < size && std::strchr(" \t\r\n", data[first]) != nullptr && data[first] != '\0')
+                first++;
+            if (first == size)
+                return true;    // Only leading whitespace so far
+            started = true;
+            html = data[first] == '<';
+        }
+        if (!html || parser == nullptr)
+            return false;
+        if (!complete())
+            htmlParseChunk(parser, data, (int)size, 0);
+        return !complete();
+    }
+
+    // The page ended; flush the parser
+    void finish(){
+        if (html && parser != nullptr && !complete())
+            htmlParseChunk(parser, nullptr, 0, 1);
+    }
+
+    bool complete() const{ return foundJackpot && foundDate; }
+
+    // Whether the page looked like HTML: error pages from proxies and empty
+    // bodies are retried
+    bool isHtml() const{ return html; }
+
+    const GameDataStruct &gameData() const{ return data; }
+
+private:
+    GameDataExtractor(const GameDataExtractor&);
+    GameDataExtractor& operator=(const GameDataExtractor&);
+
+    enum Field { NONE, JACKPOT, DATE };
+
+    static bool hasClass(const xmlChar** attrs, const char* name){
+        for (int i = 0; attrs != nullptr && attrs[i] != nullptr; i += 2)
+            if (xmlStrcasecmp(attrs[i], (const xmlChar*)"class") == 0 && attrs[i + 1] != nullptr
+                    && std::strstr((const char*)attrs[i + 1], name) != nullptr)
+                return true;
+        return false;
+    }
+
+    static void startElement(void* context, const xmlChar* name, const xmlChar** attrs){
+        GameDataExtractor* self = (GameDataExtractor*)context;
+        if (self->field != NONE) {
+            self->depth++;      // Text of nested elements counts too
+            return;
+        }
+        if (!self->foundJackpot && xmlStrcasecmp(name, (const xmlChar*)"dd") == 0
+                && hasClass(attrs, "c-next-draw-card__prize-value"))
+            self->field = JACKPOT;
+        else if (!self->foundDate && xmlStrcasecmp(name, (const xmlChar*)"time") == 0
+                && hasClass(attrs, "c-next-draw-card__date"))
+            self->field = DATE;
+        self->depth = 0;
+    }
+
+    static void endElement(void* context, const xmlChar*){
+        GameDataExtractor* self = (GameDataExtractor*)context;
+        if (self->field == NONE)
+            return;
+        if (self->depth > 0) {
+            self->depth--;
+            return;
+        }
+        if (self->field == JACKPOT)
+            self->foundJackpot = true;
+        else
+            self->foundDate = true;
+        self->field = NONE;
+        if (self->complete())
+            xmlStopParser(self->parser);
+    }
+
+    static void characters(void* context, const xmlChar* text, int length){
+        GameDataExtractor* self = (GameDataExtractor*)context;
+        if (self->field == JACKPOT)
+            self->data.currentJackpot.append((const char*)text, length);
+        else if (self->field == DATE)
+            self->data.nextDrawDate.append((const char*)text, length);
+    }
+
+    htmlSAXHandler handler;
+    htmlParserCtxtPtr parser;
+    Field field;
+    int depth;              // Elements open inside the one being captured
+    bool started;           // Seen the first non-space byte
+    bool html;
+    bool foundJackpot;
+    bool foundDate;
+    GameDataStruct data;
+};
+
+// Callback function to handle libcurl response: feeds the extractor, and
+// stops the transfer (by reporting a short write) once it has what it needs
+inline size_t writeCallback(char* buf, size_t size, size_t nmemb, GameDataExtractor* extractor) {
+    if (extractor && extractor->feed(buf, size * nmemb))
+        return size * nmemb;
+    return 0;
+}
+
+// url with its scheme and host replaced by base (e.g. http://127.0.0.1:8080),
+// so the same page paths can be served by a stand-in server
+inline std::string rebaseUrl(const std::string &url, const std::string &base){
+    size_t scheme = url.find("://");
+    size_t path = scheme == std::string::npos ? 0 : url.find('/', scheme + 3);
+    if (path == std::string::npos)
+        path = url.size();
+    std::string trimmed = base;
+    while (!trimmed.empty() && trimmed[trimmed.size() - 1] == '/')
+        trimmed.erase(trimmed.size() - 1);
+    return trimmed + url.substr(path);
+}
+
+// Limits on fetching a page, so a slow or failing server delays startup by at
+// most about maxAttempts * totalTimeoutMs plus the backoff between attempts
+struct FetchPolicy
+{
+    long connectTimeoutMs = 5000;   // Per attempt, to establish the connection
+    long totalTimeoutMs = 15000;    // Per attempt, for the whole transfer
+    int maxAttempts = 3;
+    long backoffMs = 500;           // Before the second attempt; doubles after each failure
+    long maxBackoffMs = 4000;
+};
+
+// Wait before retry number attempt (1 = first retry): exponential backoff
+// capped at maxBackoffMs, with jitter so many jobs retrying at once spread out
+inline void backoffBeforeRetry(const FetchPolicy &policy, int attempt){
+    long delay = policy.backoffMs;
+    for (int i = 1; i < attempt && delay < policy.maxBackoffMs; i++)
+        delay *= 2;
+    if (delay > policy.maxBackoffMs)
+        delay = policy.maxBackoffMs;
+
+    static std::mt19937 jitter{std::random_device{}()};
+    delay = delay / 2 + (long)(jitter() % (unsigned long)(delay / 2 + 1));
+    usleep((useconds_t)delay * 1000);
+}
+
+inline void setFetchOptions(CURL* curl, const std::string &url, GameDataExtractor* extractor, const FetchPolicy &policy){
+    curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
+    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, writeCallback);
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, extractor);
+    curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT_MS, policy.connectTimeoutMs);
+    curl_easy_setopt(curl, CURLOPT_TIMEOUT_MS, policy.totalTimeoutMs);
+    curl_easy_setopt(curl, CURLOPT_FAILONERROR, 1L);    // HTTP errors fail the attempt
+    curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);
+}
+
+// Whether a finished transfer produced a usable page, reporting why not. A
+// transfer the extractor stopped early ends in a write error but succeeded.
+inline bool pageFetched(CURLcode res, GameDataExtractor &extractor, const std::string &url){
+    if (res == CURLE_WRITE_ERROR && extractor.complete())
+        return true;
+    if (res != CURLE_OK) {
+        std::cerr << "Failed to fetch " << url << ": " << curl_easy_strerror(res) << std::endl;
+        return false;
+    }
+    if (!extractor.isHtml()) {
+        std::cerr << "Received invalid response from " << url << std::endl;
+        return false;
+    }
+    extractor.finish();
+    return true;
+}
+
+// Fetch the current jackpot and next draw date from a game's lotteryusa.com
+// page, retrying failed attempts within policy. Fields are left empty if
+// every attempt fails.
+inline GameDataStruct fetchGameData(const std::string &url, const FetchPolicy &policy = FetchPolicy()){
+    std::cout << "Fetching game data..." << std::endl;
+
+    // Initialize libcurl
+    CURL* curl = curl_easy_init();
+    if (!curl) {
+        std::cerr << "Error initializing libcurl." << std::endl;
+        return GameDataStruct();
+    }
+
+    for (int attempt = 1; attempt <= policy.maxAttempts; attempt++) {
+        if (attempt > 1) {
+            std::cerr << "Trying again..." << std::endl;
+            backoffBeforeRetry(policy, attempt - 1);
+        }
+
+        GameDataExtractor extractor;
+        setFetchOptions(curl, url, &extractor, policy);
+        if (pageFetched(curl_easy_perform(curl), extractor, url)) {
+            curl_easy_cleanup(curl);
+            return extractor.gameData();
+        }
+    }
+
+    curl_easy_cleanup(curl);
+    return GameDataStruct();
+}
+
+// Fetch several games' pages at once on one curl multi handle, in the order
+// of urls. Transfers to the same host share connections (as HTTP/2 streams
+// when the server supports it) instead of each paying for its own TLS
+// handshake. Pages that fail are fetched again, together, within policy. A
+// game whose page cannot be fetched or parsed has empty fields.
+inline std::vector<GameDataStruct> fetchGameDataConcurrently(const std::vector<std::string> &urls,
+                                                             const FetchPolicy &policy = FetchPolicy()){
+    std::cout << "Fetching game data..." << std::endl;
+
+    std::vector<GameDataStruct> games(urls.size());
+    std::vector<size_t> pending;
+    for (size_t i = 0; i < urls.size(); i++)
+        pending.push_back(i);
+
+    CURLM* multi = curl_multi_init();
+    if (!multi) {
+        std::cerr << "Error initializing libcurl." << std::endl;
+        return games;
+    }
+    curl_multi_setopt(multi, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+
+    for (int attempt = 1; attempt <= policy.maxAttempts && !pending.empty(); attempt++) {
+        if (attempt > 1) {
+            std::cerr << "Trying again..." << std::endl;
+            backoffBeforeRetry(policy, attempt - 1);
+        }
+
+        std::vector<std::unique_ptr<GameDataExtractor> > extractors(pending.size());
+        std::vector<CURL*> handles(pending.size(), nullptr);
+        std::vector<bool> fetched(pending.size(), false);
+
+        for (size_t k = 0; k < pending.size(); k++) {
+            handles[k] = curl_easy_init();
+            if (!handles[k]) {
+                std::cerr << "Error initializing libcurl." << std::endl;
+                continue;
+            }
+            extractors[k].reset(new GameDataExtractor());
+            setFetchOptions(handles[k], urls[pending[k]], extractors[k].get(), policy);
+            curl_easy_setopt(handles[k], CURLOPT_PRIVATE, (void*)k);
+            curl_easy_setopt(handles[k], CURLOPT_PIPEWAIT, 1L);    // Wait to share a connection rather than open another
+            curl_multi_add_handle(multi, handles[k]);
+        }
+
+        int running = 0;
+        do {
+            CURLMcode code = curl_multi_perform(multi, &running);
+            if (code == CURLM_OK && running)
+                code = curl_multi_poll(multi, nullptr, 0, 1000, nullptr);
+            if (code != CURLM_OK) {
+                std::cerr << "Failed to fetch data: " << curl_multi_strerror(code) << std::endl;
+                break;
+            }
+
+            CURLMsg* message;
+            int queued;
+            while ((message = curl_multi_info_read(multi, &queued)) != nullptr) {
+                if (message->msg != CURLMSG_DONE)
+                    continue;
+                void* index;
+                curl_easy_getinfo(message->easy_handle, CURLINFO_PRIVATE, &index);
+                size_t k = (size_t)index;
+                fetched[k] = pageFetched(message->data.result, *extractors[k], urls[pending[k]]);
+            }
+        } while (running);
+
+        std::vector<size_t> failed;
+        for (size_t k = 0; k < pending.size(); k++) {
+            if (handles[k]) {
+                curl_multi_remove_handle(multi, handles[k]);
+                curl_easy_cleanup(handles[k]);
+            }
+            if (fetched[k])
+                games[pending[k]] = extractors[k]->gameData();
+            else
+                failed.push_back(pending[k]);
+        }
+        pending.swap(failed);
+    }
+
+    curl_multi_cleanup(multi);
+    return games;
+}
+
+#endif
@@ -0,0 +1,145 @@
+#ifndef GAME_DATA_CACHE_H
+#define GAME_DATA_CACHE_H
+
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "gameData.h"
+
+// Fetched game data is kept in one small text file per game, so repeated runs
+// within the TTL start without touching the network:
+//
+//   url <page the data was fetched from>
+//   fetched <unix time>
+//   jackpot <current jackpot text>
+//   date <next draw date text>
+//
+// Files live in $LOTTERY_CACHE_DIR, else $XDG_CACHE_HOME/lottery, else
+// ~/.cache/lottery.
+
+inline std::string gameDataCacheDir(){
+    const char* dir = std::getenv("LOTTERY_CACHE_DIR");
+    if(dir != nullptr && *dir != '\0')
+        return dir;
+    dir = std::getenv("XDG_CACHE_HOME");
+    if(dir != nullptr && *dir != '\0')
+        return std::string(dir) + "/lottery";
+    dir = std::getenv("HOME");
+    if(dir != nullptr && *dir != '\0')
+        return std::string(dir) + "/.cache/lottery";
+    return "";
+}
+
+inline std::string gameDataCachePath(const std::string &game){
+    std::string dir = gameDataCacheDir();
+    return dir.empty() ? "" : dir + "/" + game + ".cache";
+}
+
+// Read the cached data for game if it was fetched from url less than ttl
+// seconds ago; returns false if there is no such entry. age, if given, is set
+// to the entry's age in seconds.
+inline bool readCachedGameData(const std::string &game, const std::string &url, long long ttl,
+                               GameDataStruct &gameData, long long* age = nullptr){
+    std::string path = gameDataCachePath(game);
+    if(path.empty())
+        return false;
+    std::ifstream in(path.c_str());
+    if(!in)
+        return false;
+
+    std::string line, cachedUrl;
+    long long fetched = -1;
+    GameDataStruct cached;
+    while(std::getline(in, line)){
+        size_t space = line.find(' ');
+        std::string key = line.substr(0, space);
+        std::string value = space == std::string::npos ? "" : line.substr(space + 1);
+        if(key == "url")
+            cachedUrl = value;
+        else if(key == "fetched")
+            fetched = std::atoll(value.c_str());
+        else if(key == "jackpot")
+            cached.currentJackpot = value;
+        else if(key == "date")
+            cached.nextDrawDate = value;
+    }
+
+    long long cachedAge = (long long)std::time(nullptr) - fetched;
+    if(cachedUrl != url || fetched < 0 || cachedAge < 0 || cachedAge >= ttl || cached.currentJackpot.empty())
+        return false;
+    gameData = cached;
+    if(age != nullptr)
+        *age = cachedAge;
+    return true;
+}
+
+// Store freshly fetched data for game. The file is written under a temporary
+// name and renamed into place, so concurrent runs never read a partial entry.
+// Failures are ignored: the cache only saves time.
+inline void writeCachedGameData(const std::string &game, const std::string &url, const GameDataStruct &gameData){
+    std::string dir = gameDataCacheDir();
+    if(dir.empty())
+        return;
+    for(size_t slash=dir.find('/', 1); ; slash=dir.find('/', slash + 1)){
+        mkdir(dir.substr(0, slash).c_str(), 0755);
+        if(slash == std::string::npos)
+            break;
+    }
+
+    // One entry per line, so newlines inside the fetched text become spaces
+    auto oneLine = [](std::string text){
+        for(size_t i=0; i<text.size(); i++)
+            if(text[i] == '\n' || text[i] == '\r')
+                text[i] = ' ';
+        return text;
+    };
+
+    std::string path = gameDataCachePath(game);
+    std::string temp = path + "." + std::to_string((long long)getpid()) + ".tmp";
+    {
+        std::ofstream out(temp.c_str());
+        if(!out)
+            return;
+        out << "url " << oneLine(url) << "\n"
+            << "fetched " << (long long)std::time(nullptr) << "\n"
+            << "jackpot " << oneLine(gameData.currentJackpot) << "\n"
+            << "date " << oneLine(gameData.nextDrawDate) << "\n";
+        if(!out){
+            out.close();
+            std::remove(temp.c_str());
+            return;
+        }
+    }
+    if(std::rename(temp.c_str(), path.c_str()) != 0)
+        std::remove(temp.c_str());
+}
+
+// Game data from the cache if fresh, otherwise fetched from url (which may be
+// a file:// URL) and cached. ttl <= 0 skips reading and updating the cache.
+// If the fetch fails, a stale entry of any age is used rather than nothing.
+inline GameDataStruct loadGameData(const std::string &game, const std::string &url, long long ttl,
+                                   const FetchPolicy &policy){
+    GameDataStruct gameData;
+    if(ttl > 0 && readCachedGameData(game, url, ttl, gameData))
+        return gameData;
+
+    gameData = fetchGameData(url, policy);
+    if(!gameData.currentJackpot.empty()){
+        if(ttl > 0)
+            writeCachedGameData(game, url, gameData);
+        return gameData;
+    }
+
+    long long age;
+    if(readCachedGameData(game, url, std::numeric_limits<long long>::max(), gameData, &age))
+        std::cerr << "Using cached game data from " << age / 60 << " min ago" << std::endl;
+    return gameData;
+}
+
+#endif
@@ -0,0 +1,139 @@
+#ifndef GAME_DESCRIPTORS_H
+#define GAME_DESCRIPTORS_H
+
+#include "prizeTable.h"
+
+// Compile-time description of each game. The engine in lotteryEngine.h is a
+// template over these, so every kernel is specialised with the game's pool
+// sizes and prize rules as constants.
+//
+// Each descriptor provides:
+//   title, url, drawTime     banner text and the lotteryusa.com page to scrape
+//   cacheName                file name of the game's cached page data
+//   whitePool, picks         picks distinct white numbers from 1..whitePool
+//   bonusPool, bonusName     bonus ball from 1..bonusPool; 0 if the game has none
+//   jackpotUnit              dollars per unit of a jackpot with no Million/Billion word
+//   ticketPrice              dollars per play
+//   multiplierName/Label     prompt and result text of the multiplier option
+//   multiplierPrice          extra dollars per play with the multiplier
+//   multipliers[]            multiplier values, drawn with equal probability
+//   prizes[][]               prize rule for [white matches][bonus ball matched]
+//   doublePlay               whether plays can add a second draw (Double Play)
+//   doublePlayPrice          extra dollars per play with Double Play
+//   doublePlayPrizes[][]     prize rules of the second draw (doublePlay only)
+
+// Powerball Game Rules and Prizes:
+// https://www.njlottery.com/en-us/drawgames/powerball.html#tab-oddsAndPrizes
+struct PowerballGame
+{
+    static constexpr const char* title = "P O W E R BALL";
+    static constexpr const char* url = "https://www.lotteryusa.com/powerball/";
+    static constexpr const char* cacheName = "powerball";
+    static constexpr const char* drawTime = "10:59 pm";
+    static constexpr int whitePool = 69;
+    static constexpr int picks = 5;
+    static constexpr int bonusPool = 26;
+    static constexpr const char* bonusName = "Powerball";
+    static constexpr int jackpotUnit = 1000000;
+    static constexpr int ticketPrice = 2;
+    static constexpr const char* multiplierName = "Power Play";
+    static constexpr const char* multiplierLabel = "POWERPLAY X";
+    static constexpr int multiplierPrice = 1;
+    static constexpr int multipliers[] = {2, 3, 4, 5, 10};
+
+    // Prize for [white matches][Powerball matched]. Match 5 pays a flat
+    // $2,000,000 with Power Play instead of a multiple.
+    static constexpr PrizeRule prizes[6][2] = {
+        {{0, 0},                {4, TIMES_MULTIPLIER}},
+        {{0, 0},                {4, TIMES_MULTIPLIER}},
+        {{0, 0},                {7, TIMES_MULTIPLIER}},
+        {{7, TIMES_MULTIPLIER}, {100, TIMES_MULTIPLIER}},
+        {{100, TIMES_MULTIPLIER}, {50000, TIMES_MULTIPLIER}},
+        {{1000000, 2000000},    {JACKPOT, JACKPOT}}
+    };
+
+    // Double Play enters the same numbers in a second draw held right after
+    // the main one. Its prizes are fixed and Power Play does not apply.
+    static constexpr bool doublePlay = true;
+    static constexpr int doublePlayPrice = 1;
+    static constexpr PrizeRule doublePlayPrizes[6][2] = {
+        {{0, 0},                {7, 7}},
+        {{0, 0},                {10, 10}},
+        {{0, 0},                {20, 20}},
+        {{20, 20},              {500, 500}},
+        {{500, 500},            {50000, 50000}},
+        {{500000, 500000},      {10000000, 10000000}}
+    };
+
+};
+
+// MegaMillions Game Rules and Prizes:
+// https://www.njlottery.com/en-us/drawgames/megamillions.html#tab-oddsAndPrizes
+struct MegaMillionsGame
+{
+    static constexpr const char* title = "MEGA MILLIONS";
+    static constexpr const char* url = "https://www.lotteryusa.com/mega-millions/";
+    static constexpr const char* cacheName = "mega-millions";
+    static constexpr const char* drawTime = "11:00 pm";
+    static constexpr int whitePool = 70;
+    static constexpr int picks = 5;
+    static constexpr int bonusPool = 25;
+    static constexpr const char* bonusName = "Megaball";
+    static constexpr int jackpotUnit = 1000000;
+    static constexpr int ticketPrice = 2;
+    static constexpr const char* multiplierName = "Megaplier";
+    static constexpr const char* multiplierLabel = "MEGAPLIER X";
+    static constexpr int multiplierPrice = 1;
+    static constexpr int multipliers[] = {2, 3, 4, 5};
+
+    // Prize for [white matches][Megaball matched]
+    static constexpr PrizeRule prizes[6][2] = {
+        {{0, 0},                    {2, TIMES_MULTIPLIER}},
+        {{0, 0},                    {4, TIMES_MULTIPLIER}},
+        {{0, 0},                    {10, TIMES_MULTIPLIER}},
+        {{10, TIMES_MULTIPLIER},    {200, TIMES_MULTIPLIER}},
+        {{500, TIMES_MULTIPLIER},   {10000, TIMES_MULTIPLIER}},
+        {{1000000, TIMES_MULTIPLIER}, {JACKPOT, JACKPOT}}
+    };
+
+    static constexpr bool doublePlay = false;
+    static constexpr int doublePlayPrice = 0;
+
+};
+
+// Jersey Cash 5 Game Rules and Prizes:
+// https://www.njlottery.com/en-us/drawgames/jerseycash.html#tab-oddsAndPrizes
+struct JerseyCash5Game
+{
+    static constexpr const char* title = "Jersey Cash 5";
+    static constexpr const char* url = "https://www.lotteryusa.com/new-jersey/cash-5/";
+    static constexpr const char* cacheName = "jersey-cash-5";
+    static constexpr const char* drawTime = "10:57 pm";
+    static constexpr int whitePool = 45;
+    static constexpr int picks = 5;
+    static constexpr int bonusPool = 0;
+    static constexpr const char* bonusName = "";
+    static constexpr int jackpotUnit = 1000;
+    static constexpr int ticketPrice = 1;
+    static constexpr const char* multiplierName = "Xtra";
+    static constexpr const char* multiplierLabel = "Xtra X";
+    static constexpr int multiplierPrice = 1;
+    static constexpr int multipliers[] = {2, 3, 4, 5};
+
+    // Prize for [matches][unused: no bonus ball]. Match 2 pays $2 only with
+    // Xtra.
+    static constexpr PrizeRule prizes[6][2] = {
+        {{0, 0},                    {0, 0}},
+        {{0, 0},                    {0, 0}},
+        {{0, 2},                    {0, 0}},
+        {{15, TIMES_MULTIPLIER},    {0, 0}},
+        {{500, TIMES_MULTIPLIER},   {0, 0}},
+        {{JACKPOT, JACKPOT},        {0, 0}}
+    };
+
+    static constexpr bool doublePlay = false;
+    static constexpr int doublePlayPrice = 0;
+
+};
+
+#endif
@@ -0,0 +1,188 @@
+#ifndef GAME_ODDS_H
+#define GAME_ODDS_H
+
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include "money.h"
+#include "prizeTable.h"
+#include "textUtils.h"
+
+// Exact odds and expected value of a ticket, from hypergeometric counts over
+// the game's pools and the prize rules in its descriptor. No simulation.
+
+// Binomial coefficients C(n, k) for n up to the white pool and k up to the
+// number of picks, built at compile time. Every entry fits in 64 bits.
+template<class Game>
+struct BinomialTable
+{
+    unsigned long long ways[Game::whitePool + 1][Game::picks + 1] = {};
+
+    constexpr BinomialTable(){
+        for(int n=0; n<=Game::whitePool; n++){
+            ways[n][0] = 1;
+            for(int k=1; k<=Game::picks && k<=n; k++)
+                ways[n][k] = ways[n - 1][k - 1] + (k <= n - 1 ? ways[n - 1][k] : 0);
+        }
+    }
+};
+
+// Number of equally likely tickets, and how many of them land in each
+// [white matches][bonus matched] cell
+template<class Game>
+struct TierCounts
+{
+    unsigned long long total = 0;
+    unsigned long long ways[Game::picks + 1][2] = {};
+
+    constexpr TierCounts(){
+        constexpr BinomialTable<Game> binomial;
+        constexpr int bonus = Game::bonusPool > 0 ? Game::bonusPool : 1;
+
+        total = binomial.ways[Game::whitePool][Game::picks] * bonus;
+        for(int white=0; white<=Game::picks; white++){
+            unsigned long long whiteWays = binomial.ways[Game::picks][white]
+                * binomial.ways[Game::whitePool - Game::picks][Game::picks - white];
+            if(Game::bonusPool > 0){
+                ways[white][1] = whiteWays;
+                ways[white][0] = whiteWays * (Game::bonusPool - 1);
+            }
+            else
+                ways[white][0] = whiteWays;
+        }
+    }
+};
+
+// Probability that a random ticket matches exactly matching_white of the
+// drawn white balls and (if matchesBonus) the bonus ball
+template<class Game>
+double tierProbability(int matching_white, bool matchesBonus){
+    static constexpr TierCounts<Game> counts;
+    return (double)counts.ways[matching_white][matchesBonus] / counts.total;
+}
+
+// A prize tier is any [white matches][bonus matched] cell that can pay
+template<class Game>
+bool isPrizeTier(int matching_white, bool matchesBonus, const PrizeRule (*rules)[2] = Game::prizes){
+    const PrizeRule &rule = rules[matching_white][matchesBonus];
+    return rule.amount != 0 || rule.withMultiplier != 0;
+}
+
+// Expected prize of one tier: the prize itself, or with the multiplier the
+// mean over the multipliers, which are drawn with equal probability
+template<class Game>
+double expectedTierPrize(Money jackpot, bool withMultiplier, int matching_white, bool matchesBonus){
+    if(!withMultiplier)
+        return (double)PrizeTable<Game>(jackpot, 1)(matching_white, matchesBonus);
+
+    constexpr int count = sizeof(Game::multipliers) / sizeof(Game::multipliers[0]);
+    double sum = 0.0;
+    for(int i=0; i<count; i++)
+        sum += (double)PrizeTable<Game>(jackpot, Game::multipliers[i])(matching_white, matchesBonus);
+    return sum / count;
+}
+
+// Expected winnings of one ticket, plus its Double Play draw if withDoublePlay
+template<class Game>
+double expectedWinnings(Money jackpot, bool withMultiplier, bool withDoublePlay = false){
+    double expected = 0.0;
+    for(int white=0; white<=Game::picks; white++)
+        for(int bonus=0; bonus<2; bonus++)
+            if(isPrizeTier<Game>(white, bonus))
+                expected += tierProbability<Game>(white, bonus)
+                    * expectedTierPrize<Game>(jackpot, withMultiplier, white, bonus);
+    if constexpr (Game::doublePlay){
+        if(withDoublePlay){
+            const PrizeTable<Game> doublePlay(jackpot, 1, Game::doublePlayPrizes);
+            for(int white=0; white<=Game::picks; white++)
+                for(int bonus=0; bonus<2; bonus++)
+                    expected += tierProbability<Game>(white, bonus) * doublePlay(white, bonus);
+        }
+    }
+    return expected;
+}
+
+// "1 in N" for a probability, or "-" if it never happens
+inline std::string formatOdds(double probability){
+    if(probability <= 0.0)
+        return "-";
+    double odds = 1.0 / probability;
+    if(odds >= 100.0)
+        return "1 in " + formatWithCommas(std::llround(odds));
+    std::ostringstream text;
+    text << "1 in " << std::fixed << std::setprecision(2) << odds;
+    return text.str();
+}
+
+// Print the odds, expected prize and expected value of every prize tier,
+// then the totals per ticket. withDoublePlay adds the tiers of Powerball's
+// Double Play draw, its price and its share of the return.
+template<class Game>
+void printOdds(Money jackpot, bool withMultiplier, std::ostream &out, bool withDoublePlay = false){
+    const int ticket_price = Game::ticketPrice + (withMultiplier ? Game::multiplierPrice : 0)
+        + (withDoublePlay ? Game::doublePlayPrice : 0);
+    double no_prize = 1.0;      // Chance of winning nothing in any draw of the ticket
+    double expected = 0.0;
+
+    out << "\n" << Game::title << " odds and expected value\n"
+        << "Jackpot:            $" << formatWithCommas(jackpot) << "\n"
+        << Game::multiplierName << ":" << std::string(19 - std::string(Game::multiplierName).size(), ' ')
+        << (withMultiplier ? "on" : "off") << "\n";
+    if(withDoublePlay)
+        out << "Double Play:        on\n";
+    out << "\n";
+
+    // One table row per prize tier of a draw; prize_of(white, bonus) is the
+    // tier's expected prize
+    auto printTiers = [&](auto prize_of){
+        double any_prize = 0.0;
+        for(int white=Game::picks; white>=0; white--)
+            for(int bonus=1; bonus>=0; bonus--){
+                if(!isPrizeTier<Game>(white, bonus))
+                    continue;
+                std::string tier = std::to_string(white);
+                if(bonus)
+                    tier += std::string(" + ") + Game::bonusName;
+                double probability = tierProbability<Game>(white, bonus);
+                double prize = prize_of(white, bonus);
+                if(prize > 0.0)
+                    any_prize += probability;
+                expected += probability * prize;
+
+                std::ostringstream prize_text, value_text;
+                if(prize == std::floor(prize))
+                    prize_text << "$" << formatWithCommas(std::llround(prize));
+                else
+                    prize_text << "$" << std::fixed << std::setprecision(2) << prize;
+                value_text << "$" << std::fixed << std::setprecision(6) << probability * prize;
+                out << std::left << std::setw(16) << tier << std::right << std::setw(20) << formatOdds(probability)
+                    << std::setw(20) << prize_text.str() << std::setw(16) << value_text.str() << "\n";
+            }
+        no_prize *= 1.0 - any_prize;
+    };
+
+    out << std::left << std::setw(16) << "Tier" << std::right << std::setw(20) << "Odds"
+        << std::setw(20) << "Prize" << std::setw(16) << "Value" << "\n";
+    printTiers([&](int white, bool bonus){
+        return expectedTierPrize<Game>(jackpot, withMultiplier, white, bonus);
+    });
+    if constexpr (Game::doublePlay){
+        if(withDoublePlay){
+            const PrizeTable<Game> double_play(jackpot, 1, Game::doublePlayPrizes);
+            out << "\nDouble Play\n";
+            printTiers([&](int white, bool bonus){
+                return (double)double_play(white, bonus);
+            });
+        }
+    }
+
+    out << "\nOdds of any prize:  " << formatOdds(1.0 - no_prize) << "\n"
+        << "Price per Ticket:   $" << ticket_price << "\n"
+        << "Expected Winnings:  $" << std::fixed << std::setprecision(6) << expected << "\n"
+        << "Return per $1:      $" << expected / ticket_price << "\n"
+        << std::defaultfloat << std::endl;
+}
+
+#endif
@@ -0,0 +1,188 @@
+#ifndef HISTORY_FILE_H
+#define HISTORY_FILE_H
+
+#include <algorithm>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "money.h"
+#include "textUtils.h"
+#include "ticketFile.h"
+
+// History files list official draws as CSV, one draw per line:
+//
+//   date, white numbers, bonus number, multiplier, jackpot
+//
+// The white numbers may be one field each or share a field separated by
+// spaces or dashes ("09 12 19 26 61"), as in the state open-data exports; the
+// bonus number is left out for games without one. The multiplier and jackpot
+// fields are optional: an empty multiplier means none was drawn, and the
+// jackpot is dollars ("40000000" or "$40,000,000") or text such as
+// "$1.2 Billion". Unlike on the game pages, a bare number is never in
+// millions. Fields may be quoted.
+// A header line, blank lines and lines starting with # are ignored.
+
+// One historical draw. jackpot is 0 if the file did not give one.
+struct HistoricalDraw
+{
+    char date[16];
+    int balls[6];       // White numbers, then the bonus number (0 if none)
+    int multiplier;     // 1 if none was drawn
+    Money jackpot;
+};
+
+// Find the field starting at p on a line ending at end: sets field/fieldEnd
+// to its contents without quotes or surrounding spaces, and returns the start
+// of the next field (end if this was the last)
+inline const char* nextCsvField(const char* p, const char* end, const char* &field, const char* &fieldEnd){
+    while(p < end && (*p == ' ' || *p == '\t'))
+        p++;
+    if(p < end && *p == '"'){
+        field = ++p;
+        const char* quote = (const char*)std::memchr(p, '"', end - p);
+        fieldEnd = quote != nullptr ? quote : end;
+        p = fieldEnd;
+    }
+    else{
+        field = p;
+        const char* comma = (const char*)std::memchr(p, ',', end - p);
+        p = comma != nullptr ? comma : end;
+        fieldEnd = p;
+    }
+    while(fieldEnd > field && (fieldEnd[-1] == ' ' || fieldEnd[-1] == '\t'))
+        fieldEnd--;
+
+    const char* comma = (const char*)std::memchr(p, ',', end - p);
+    return comma != nullptr ? comma + 1 : end;
+}
+
+inline bool hasDigit(const char* p, const char* end){
+    for(; p < end; p++)
+        if(*p >= '0' && *p <= '9')
+            return true;
+    return false;
+}
+
+// Parse one line (without its newline) into draw; returns nullptr if valid,
+// otherwise the problem
+inline const char* parseHistoryLine(const char* p, const char* end, const TicketRules &rules, HistoricalDraw &draw){
+    const int expected = rules.ballsPerTicket();
+    const char* field;
+    const char* fieldEnd;
+
+    p = nextCsvField(p, end, field, fieldEnd);
+    size_t length = std::min<size_t>(fieldEnd - field, sizeof(draw.date) - 1);
+    std::memcpy(draw.date, field, length);
+    draw.date[length] = '\0';
+
+    int count = 0;
+    for(int j=0; j<6; j++)
+        draw.balls[j] = 0;
+    while(count < expected){
+        if(p == end)
+            return expected == 6 ? "expected 5 numbers and a bonus number" : "expected 5 numbers";
+        p = nextCsvField(p, end, field, fieldEnd);
+        for(const char* q=field; q < fieldEnd; ){
+            if(*q >= '0' && *q <= '9'){
+                int value = 0;
+                for(; q < fieldEnd && *q >= '0' && *q <= '9'; q++)
+                    if(value < 1000)    // Any larger number is out of range anyway
+                        value = value * 10 + (*q - '0');
+                if(count == expected)
+                    return "too many numbers";
+                draw.balls[count++] = value;
+            }
+            else if(*q == ' ' || *q == '-')
+                q++;
+            else
+                return "unexpected character in numbers";
+        }
+    }
+    const char* problem = validateTicketNumbers(draw.balls, rules);
+    if(problem != nullptr)
+        return problem;
+
+    // Multiplier: digits with an optional x ("2", "2X", "x2")
+    draw.multiplier = 1;
+    if(p < end){
+        p = nextCsvField(p, end, field, fieldEnd);
+        if(field < fieldEnd){
+            int value = 0;
+            for(const char* q=field; q < fieldEnd; q++){
+                if(*q >= '0' && *q <= '9' && value < 1000)
+                    value = value * 10 + (*q - '0');
+                else if(*q != 'x' && *q != 'X')
+                    return "unexpected character in multiplier";
+            }
+            if(value < 1)
+                return "multiplier out of range";
+            draw.multiplier = value;
+        }
+    }
+
+    draw.jackpot = 0;
+    if(p < end){
+        p = nextCsvField(p, end, field, fieldEnd);
+        if(field < fieldEnd && !hasDigit(field, fieldEnd))
+            return "jackpot has no amount";
+        draw.jackpot = jackpotFromText(field, fieldEnd, 1);
+    }
+    return nullptr;
+}
+
+// Load every draw in a history file, in file order. Returns false with error
+// set (naming the offending line) if the file cannot be read or holds an
+// invalid draw.
+inline bool loadHistoryFile(const std::string &path, const TicketRules &rules, std::vector<HistoricalDraw> &draws,
+                            std::string &error){
+    MappedFile file;
+    if(!file.open(path, error))
+        return false;
+
+    const char* p = file.begin();
+    const char* end = p + file.size();
+    long long line = 0;
+    bool first = true;
+
+    draws.clear();
+    while(p < end){
+        const char* next = nextLineStart(p, end);
+        const char* lineEnd = next;
+        while(lineEnd > p && (lineEnd[-1] == '\n' || lineEnd[-1] == '\r'))
+            lineEnd--;
+        line++;
+
+        const char* start = p;
+        p = next;
+        while(start < lineEnd && (*start == ' ' || *start == '\t'))
+            start++;
+        if(start == lineEnd || *start == '#')
+            continue;
+
+        // A header has no digits in its first numbers field
+        if(first){
+            first = false;
+            const char* field;
+            const char* fieldEnd;
+            const char* second = nextCsvField(start, lineEnd, field, fieldEnd);
+            nextCsvField(second, lineEnd, field, fieldEnd);
+            if(!hasDigit(field, fieldEnd))
+                continue;
+        }
+
+        HistoricalDraw draw;
+        const char* problem = parseHistoryLine(start, lineEnd, rules, draw);
+        if(problem != nullptr){
+            error = path + ": line " + std::to_string(line) + ": " + problem;
+            return false;
+        }
+        draws.push_back(draw);
+    }
+    if(draws.empty()){
+        error = path + ": no draws";
+        return false;
+    }
+    return true;
+}
+
+#endif
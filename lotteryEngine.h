@@ -0,0 +1,1260 @@
+#ifndef LOTTERY_ENGINE_H
+#define LOTTERY_ENGINE_H
+
+#include <algorithm>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "ballMask.h"
+#include "gameDataCache.h"
+#include "gameDescriptors.h"
+#include "gameOdds.h"
+#include "historyFile.h"
+#include "money.h"
+#include "outputBuffer.h"
+#include "parallelSim.h"
+#include "philox.h"
+#include "prizeTable.h"
+#include "quickPick.h"
+#include "quickPickBatch.h"
+#include "runningStats.h"
+#include "simOptions.h"
+#include "textUtils.h"
+#include "ticketBatch.h"
+#include "ticketIndex.h"
+#include "tierHistogram.h"
+#include "ticketFile.h"
+#include "ticketStore.h"
+
+// One engine for every game. Game is a descriptor from gameDescriptors.h, so
+// pool sizes, pick counts and prize rules are compile-time constants in each
+// kernel below.
+
+// A ticket or a draw: white balls as a bitmask plus the bonus ball (always 0
+// for games without one)
+template<class Game>
+struct Ticket
+{
+    BallMask<Game::whitePool> white;
+    int bonus;
+};
+
+template<class Game>
+using WhiteBallSampler = QuickPickSampler<Game::whitePool, Game::picks>;
+
+// Generate a quick pick ticket or the winning numbers
+template<class Game, class Generator>
+void generateTicket(Ticket<Game> &ticket, WhiteBallSampler<Game> &sampler, Generator &gen){
+    sampler.draw(gen, ticket.white);
+    if constexpr (Game::bonusPool > 0)
+        ticket.bonus = 1 + boundedRandom(gen, Game::bonusPool);
+    else
+        ticket.bonus = 0;
+}
+
+// Draw the multiplier for a draw played with Power Play / Megaplier / Xtra
+template<class Game, class Generator>
+int drawMultiplier(Generator &gen){
+    constexpr int count = sizeof(Game::multipliers) / sizeof(Game::multipliers[0]);
+    return Game::multipliers[boundedRandom(gen, count)];
+}
+
+// What the numbers of a PhiloxStream are for. With the run seed, a round
+// and an index they select the stream, so any ticket, draw or multiplier of
+// a run can be computed on its own, on any thread, in any order.
+enum RandomStream
+{
+    STREAM_TICKET,          // Quick pick number index of a round
+    STREAM_DRAW,            // Winning numbers of draw index of a round
+    STREAM_DOUBLE_PLAY,     // Double Play numbers after draw index
+    STREAM_MULTIPLIER,      // Multiplier of draw index
+    STREAM_TIER             // Importance sampling: tier and numbers of ticket index
+};
+
+// Generate the ticket or winning numbers of one stream
+template<class Game>
+void generateTicket(Ticket<Game> &ticket, WhiteBallSampler<Game> &sampler, unsigned long long seed,
+                    RandomStream stream, long long round, long long index){
+    PhiloxStream random(seed, stream, round, index);
+    generateTicket(ticket, sampler, random);
+}
+
+// The quick picks index firstIndex to firstIndex + count - 1 of a round,
+// exactly as generateTicket() makes them one at a time, but eight at a time
+// when the CPU has AVX2
+template<class Game>
+void generateQuickPicks(Ticket<Game>* tickets, int count, WhiteBallSampler<Game> &sampler, unsigned long long seed,
+                        long long round, long long firstIndex){
+    int j = 0;
+#ifdef SIMD_AVX2
+    if(cpuHasAvx2()){
+        QuickPickLanes<Game::picks> lanes;
+        for(; j + QUICK_PICK_LANES <= count; j += QUICK_PICK_LANES){
+            quickPickLanesAvx2<Game::whitePool, Game::picks, Game::bonusPool>(seed, STREAM_TICKET, round,
+                                                                               firstIndex + j, lanes);
+            for(int l=0; l<QUICK_PICK_LANES; l++){
+                Ticket<Game> &ticket = tickets[j + l];
+                if(lanes.redo >> l & 1){
+                    generateTicket(ticket, sampler, seed, STREAM_TICKET, round, firstIndex + j + l);
+                    continue;
+                }
+                ticket.white.clear();
+                for(int i=0; i<Game::picks; i++)
+                    ticket.white.set(lanes.balls[i][l]);
+                ticket.bonus = Game::bonusPool > 0 ? (int)lanes.balls[Game::picks][l] : 0;
+            }
+        }
+    }
+#endif
+    for(; j<count; j++)
+        generateTicket(tickets[j], sampler, seed, STREAM_TICKET, round, firstIndex + j);
+}
+
+// The multiplier of draw index of a round
+template<class Game>
+int drawMultiplier(unsigned long long seed, long long round, long long index){
+    PhiloxStream random(seed, STREAM_MULTIPLIER, round, index);
+    return drawMultiplier<Game>(random);
+}
+
+template<class Game>
+bool matchesBonus(const Ticket<Game> &ticket, const Ticket<Game> &winning){
+    return Game::bonusPool > 0 && ticket.bonus == winning.bonus;
+}
+
+// Build a ticket from validated numbers read from a ticket file
+template<class Game>
+Ticket<Game> ticketFromNumbers(const int numbers[6]){
+    Ticket<Game> ticket;
+
+    ticket.white.clear();
+    for(int j=0; j<Game::picks; j++)
+        ticket.white.set(numbers[j]);
+    ticket.bonus = Game::bonusPool > 0 ? numbers[5] : 0;
+    return ticket;
+}
+
+// Write ticket numbers, with numbers matching the winning numbers in surrounding parenthases
+template<class Game>
+void writeTicket(OutputBuffer &out, const Ticket<Game> &ticket, const Ticket<Game> &winning){
+    forEachBall(ticket.white, [&](int ball){
+        if(winning.white.test(ball)){
+            out.put('(');
+            out.number(ball);
+            out.put(")\t");
+        }
+        else{
+            out.number(ball);
+            out.put('\t');
+        }
+    });
+    if constexpr (Game::bonusPool > 0){
+        if(ticket.bonus == winning.bonus){
+            out.put('(');
+            out.number(ticket.bonus);
+            out.put(")\t");
+        }
+        else{
+            out.number(ticket.bonus);
+            out.put('\t');
+        }
+    }
+}
+
+// Write the winning numbers without parenthases
+template<class Game>
+void writeWinningNumbers(OutputBuffer &out, const Ticket<Game> &winning){
+    forEachBall(winning.white, [&](int ball){
+        out.number(ball);
+        out.put('\t');
+    });
+    if constexpr (Game::bonusPool > 0){
+        out.number(winning.bonus);
+        out.put('\t');
+    }
+}
+
+// Write a ticket line ending with its winnings, if any
+template<class Game>
+void writeTicketLine(OutputBuffer &out, const Ticket<Game> &ticket, const Ticket<Game> &winning, Money winnings){
+    writeTicket(out, ticket, winning);
+    if(winnings != 0){
+        out.put('$');
+        out.withCommas(winnings);
+    }
+    out.put('\n');
+}
+
+// What a ticket wins against the winning numbers of a draw with prizes
+template<class Game>
+Money playPrize(const Ticket<Game> &ticket, const Ticket<Game> &winning, const PrizeTable<Game> &prizes){
+    return prizes(countMatches(ticket.white, winning.white), matchesBonus(ticket, winning));
+}
+
+// Write a ticket line with its winnings and return the winnings
+template<class Game>
+Money playTicket(OutputBuffer &out, const Ticket<Game> &ticket, const Ticket<Game> &winning,
+                 const PrizeTable<Game> &prizes){
+    Money ticket_winnings = playPrize(ticket, winning, prizes);
+    writeTicketLine(out, ticket, winning, ticket_winnings);
+    return ticket_winnings;
+}
+
+// Read one hand-picked ticket from cin, asking again for invalid numbers
+template<class Game>
+void readTicket(Ticket<Game> &ticket){
+    int user_selected_num;
+
+    std::cout << "Enter " << Game::picks << " numbers between 1 and " << Game::whitePool << ":" << std::endl;
+    ticket.white.clear();
+    for(int j=0; j<Game::picks; j++){
+        bool done = false;
+        do{
+            std::cin >> user_selected_num;
+            if((user_selected_num < 1) || (user_selected_num > Game::whitePool)) // Not in valid range
+                std::cout << "\nNumber must be between 1 and " << Game::whitePool << std::endl;
+            else if(ticket.white.test(user_selected_num))    // Num already chosen
+                std::cout << "\nNumber already chosen" << std::endl;
+            else    //Valid number selection
+            {
+                ticket.white.set(user_selected_num);
+                done = true;
+            }
+        }
+        while(!done);
+    }
+
+    ticket.bonus = 0;
+    if constexpr (Game::bonusPool > 0){
+        std::cout << "\nPick 1 " << Game::bonusName << " number between 1 and " << Game::bonusPool << ":" << std::endl;
+        do{
+            std::cin >> ticket.bonus;
+            if((ticket.bonus < 1) || (ticket.bonus > Game::bonusPool))
+                std::cout << "\nNumber must be between 1 and " << Game::bonusPool << std::endl;
+        }
+        while((ticket.bonus < 1) || (ticket.bonus > Game::bonusPool));
+    }
+}
+
+// One draw a ticket is entered in: the winning numbers and the prizes they pay
+template<class Game>
+struct Draw
+{
+    Ticket<Game> winning;
+    int multiplier;
+    bool doublePlay;    // The Double Play draw after a main draw
+    PrizeTable<Game> prizes;
+};
+
+// Tickets scored per block by scoreTickets(); a block (24KB of Powerball
+// tickets) stays in L1 cache while it is scored against every draw
+const int TICKET_BLOCK = 1024;
+
+// Score count tickets (at most TICKET_BLOCK) against every draw in draws,
+// adding to tally.draws[d] for draw d. The block is copied into columns
+// once, then scored against each draw in turn, so each ticket is read from
+// memory once however many draws it is entered in.
+template<class Game>
+void scoreTickets(const Ticket<Game>* tickets, int count, const std::vector<Draw<Game> > &draws,
+                  MultiDrawTally &tally){
+    TicketBatch<Game::whitePool, TICKET_BLOCK> batch;
+    uint8_t tiers[TICKET_BLOCK];
+    batch.assign(tickets, count);
+    for(size_t d=0; d<draws.size(); d++){
+        const Ticket<Game> &winning = draws[d].winning;
+        scoreBatch(batch, winning.white, winning.bonus, Game::bonusPool > 0, tiers);
+        // Consecutive tickets count into alternate histograms, so increments
+        // of the same tier do not wait on each other
+        int hits[2][(Game::picks + 1) * 2] = {};
+        for(int j=0; j<count; j++)
+            hits[j & 1][tiers[j]]++;
+
+        SimTally &draw_tally = tally.draws[d];
+        draw_tally.tickets += count;
+        for(int white=0; white<=Game::picks; white++)
+            for(int bonus=0; bonus<2; bonus++)
+                draw_tally.hits[white][bonus] += hits[0][tierIndex(white, bonus)] + hits[1][tierIndex(white, bonus)];
+    }
+}
+
+// Write a line for each of count tickets in each draw, or only for those that
+// win something if winnersOnly, to out. Each line starts with its draw's label.
+template<class Game>
+void listTickets(const Ticket<Game>* tickets, int count, const std::vector<Draw<Game> > &draws,
+                 const std::vector<std::string> &labels, bool winnersOnly, OutputBuffer &out){
+    for(int j=0; j<count; j++)
+        for(size_t d=0; d<draws.size(); d++){
+            const Ticket<Game> &winning = draws[d].winning;
+            Money winnings = draws[d].prizes(countMatches(tickets[j].white, winning.white), matchesBonus(tickets[j], winning));
+            if(winnersOnly && winnings == 0)
+                continue;
+            out.put(labels[d]);
+            writeTicketLine(out, tickets[j], winning, winnings);
+        }
+}
+
+// The ticket blocks a worker scores: first, first + step, ... up to end.
+// Workers normally take their runParallel() share (first, up to first +
+// count) in one run. When listing, worker t takes blocks t, t + workers,
+// ... of all plays instead, so the workers move through the tickets side by
+// side and an OrderedOutput can write each block's lines as soon as the
+// blocks before it are written, holding at most a block per worker.
+inline void workerBlocks(long long plays, int workers, int worker, long long count, bool listing,
+                         long long &first, long long &end, long long &step){
+    if(!listing){
+        end = first + count;
+        step = TICKET_BLOCK;
+        return;
+    }
+    first = (long long)worker * TICKET_BLOCK;
+    end = plays;
+    step = (long long)workers * TICKET_BLOCK;
+}
+
+// Write a draw's line: label, winning numbers, multiplier and what the
+// tickets won in it
+template<class Game>
+void writeDrawLine(OutputBuffer &out, const std::string &label, const Draw<Game> &draw, Money winnings){
+    out.put(label);
+    writeWinningNumbers(out, draw.winning);
+    if(draw.multiplier > 1){
+        out.put(Game::multiplierLabel);
+        out.number(draw.multiplier);
+        out.put('\t');
+    }
+    out.put("Winnings: $");
+    out.withCommas(winnings);
+}
+
+// Ticket pools at least this large, scored against at least this many draws,
+// go through an inverted index. Building it costs about ten linear scans. On
+// CPUs with AVX2 the column kernel of scoreTickets() scores a ticket nearly
+// as fast as the index, so the build takes far more draws to pay off.
+const size_t INDEX_MIN_TICKETS = 1 << 16;
+const long long INDEX_MIN_DRAWS = 16;
+const long long INDEX_MIN_DRAWS_AVX2 = 64;
+
+inline long long indexMinDraws(){
+#ifdef SIMD_AVX2
+    if(cpuHasAvx2())
+        return INDEX_MIN_DRAWS_AVX2;
+#endif
+    return INDEX_MIN_DRAWS;
+}
+
+// Index each worker's share of a large pool once, on the worker's thread, if
+// it is worth it for draws_scored draws. Scoring then only needs the index,
+// so the pool itself is released; indexes stays empty otherwise.
+template<class Game>
+void indexTicketPool(std::vector<Ticket<Game> > &pool, long long draws_scored, int threads,
+                     std::vector<TicketIndex<Game::whitePool, Game::bonusPool> > &indexes){
+    if(pool.size() < INDEX_MIN_TICKETS || draws_scored < indexMinDraws())
+        return;
+    const long long plays = (long long)pool.size();
+    std::vector<std::thread> builders;
+    indexes.resize(parallelWorkers(plays, threads));
+    for(size_t t=0; t<indexes.size(); t++){
+        long long first, count;
+        workerShare(plays, (int)indexes.size(), (int)t, first, count);
+        builders.emplace_back([&indexes, &pool, t, first, count](){
+            indexes[t].build(&pool[first], (uint32_t)count);
+        });
+    }
+    for(size_t t=0; t<builders.size(); t++)
+        builders[t].join();
+    std::vector<Ticket<Game> >().swap(pool);
+}
+
+// Runs stop on --target-ci only once they have this many observations, and
+// every prize tier but the jackpot has been hit this many times: until then
+// the observed variance leaves out the rare large prizes and is far too small.
+// No practical run sees the jackpot, so its share is not in the interval.
+const long long MIN_CONVERGENCE_SAMPLES = 30;
+const long long MIN_TIER_HITS = 10;
+
+// Add the tickets of one draw to stats as a batch of observations, each
+// ticket's being the value of its [white matches][bonus matched] tier
+template<class Game>
+void addTierValues(const SimTally &tally, const double (*value)[2], RunningStats &stats){
+    if(tally.tickets == 0)
+        return;
+    double sum = 0.0;
+    for(int white=0; white<=Game::picks; white++)
+        for(int bonus=0; bonus<2; bonus++)
+            sum += tally.hits[white][bonus] * value[white][bonus];
+    const double mean = sum / tally.tickets;
+    double m2 = 0.0;
+    for(int white=0; white<=Game::picks; white++)
+        for(int bonus=0; bonus<2; bonus++){
+            double deviation = value[white][bonus] - mean;
+            m2 += tally.hits[white][bonus] * deviation * deviation;
+        }
+    stats.addBatch(tally.tickets, mean, m2);
+}
+
+// Each tier's prize per dollar of ticket price, for a main draw or, with
+// doublePlay, a Double Play draw. With withMultiplier a main draw's tiers are
+// valued at their mean prize over the multipliers: the tickets of a draw all
+// share its multiplier, so valuing them at the multiplier drawn would make
+// them dependent observations and leave the multiplier's variance out of
+// the interval.
+template<class Game>
+void tierReturns(Money jackpot, bool withMultiplier, bool doublePlay, int ticket_price, double (*value)[2]){
+    for(int white=0; white<=Game::picks; white++)
+        for(int bonus=0; bonus<2; bonus++){
+            double prize = 0.0;
+            if constexpr (Game::doublePlay){
+                if(doublePlay)
+                    prize = (double)PrizeTable<Game>(jackpot, 1, Game::doublePlayPrizes)(white, bonus);
+            }
+            if(!doublePlay)
+                prize = expectedTierPrize<Game>(jackpot, withMultiplier, white, bonus);
+            value[white][bonus] = prize / ticket_price;
+        }
+}
+
+// Half width of the 95% CI on the return per $1 of a ticket and its Double
+// Play draw, whose returns are independent
+inline double returnHalfWidth(const RunningStats (&returns)[2]){
+    double main = returns[0].halfWidth();
+    double double_play = returns[1].count > 0 ? returns[1].halfWidth() : 0.0;
+    return std::sqrt(main * main + double_play * double_play);
+}
+
+// Whether every prize tier but the jackpot has MIN_TIER_HITS hits and, if
+// relative > 0, a 95% CI on its frequency narrower than relative times the
+// frequency
+template<class Game>
+bool tiersConverged(const TierHistogram<Game> &histogram, double relative){
+    const long long tickets = histogram.totalTickets();
+    for(int white=0; white<=Game::picks; white++)
+        for(int bonus=0; bonus<2; bonus++){
+            if(!isPrizeTier<Game>(white, bonus) || Game::prizes[white][bonus].amount == JACKPOT)
+                continue;
+            long long hits = histogram.totalHits(white, bonus);
+            if(hits < MIN_TIER_HITS)
+                return false;
+            if(relative > 0.0 && 2 * frequencyHalfWidth(hits, tickets) > relative * hits / tickets)
+                return false;
+        }
+    return true;
+}
+
+// Headless run: play options.rounds rounds of options.plays quick picks each
+// (or of the tickets in options.ticketFile) and print aggregate results, plus
+// as much of each round as options.output asks for. Each round's tickets are
+// entered in options.draws consecutive draws, plus the Double Play draw after
+// each one if options.doublePlay. The tickets of a round are split across
+// worker threads; every ticket and draw comes from its own counter-based
+// stream of the run seed, so results do not depend on the thread count. With
+// options.targetCi the run stops after the first round at which the results
+// have converged. Returns the process exit code.
+template<class Game>
+int runBatch(const SimOptions &options, Money jackpot){
+    const unsigned long long seed = resolveSeed(options);
+    const int threads = resolveThreads(options);
+    const int ticket_price = Game::ticketPrice + (options.multiplier ? Game::multiplierPrice : 0)
+        + (options.doublePlay ? Game::doublePlayPrice : 0);
+    WhiteBallSampler<Game> sampler;
+    SimTally total;
+    SimTally double_play_total;
+    TierHistogram<Game> histogram;
+    std::vector<Ticket<Game> > pool;
+    std::vector<Draw<Game> > draws;
+    std::vector<std::string> labels;
+    OutputBuffer out(stdout);
+    const bool listing = options.output >= OUTPUT_WINNERS;
+
+    if(!options.ticketFile.empty()){
+        const TicketRules rules = {Game::whitePool, Game::bonusPool};
+        std::string error;
+        if(!loadTicketFile(options.ticketFile, rules, threads, ticketFromNumbers<Game>, pool, error)){
+            std::cerr << "Failed to load tickets: " << error << std::endl;
+            return 1;
+        }
+    }
+    const long long plays = options.ticketFile.empty() ? options.plays : (long long)pool.size();
+    if(plays == 0 && options.targetCi > 0.0){
+        std::cerr << "--target-ci needs at least one ticket, and " << options.ticketFile << " has none" << std::endl;
+        return 1;
+    }
+
+    std::vector<TicketIndex<Game::whitePool, Game::bonusPool> > indexes;
+    if(!listing)
+        indexTicketPool(pool, std::min(options.rounds, indexMinDraws()) * options.draws * (options.doublePlay ? 2 : 1),
+                        threads, indexes);
+    const int workers = parallelWorkers(plays, threads);
+
+    // Returns per $1 for --target-ci, kept apart for main and Double Play
+    // draws. Quick picks are independent, so each ticket in each draw is an
+    // observation, valued by tierReturns(); a fixed pool shares every draw,
+    // so each draw is one.
+    RunningStats returns[2];
+    double tier_returns[2][Game::picks + 1][2];
+    for(int double_play=0; double_play<2; double_play++)
+        tierReturns<Game>(jackpot, options.multiplier, double_play, ticket_price, tier_returns[double_play]);
+    long long rounds_played = 0;
+    bool converged = false;
+
+    for(long long round=1; round<=options.rounds && !converged; round++){
+        draws.clear();
+        labels.clear();
+        for(long long d=0; d<options.draws; d++){
+            Ticket<Game> winning;
+            std::string label = "Round " + std::to_string(round);
+            if(options.draws > 1)
+                label += ", Draw " + std::to_string(d + 1);
+            generateTicket(winning, sampler, seed, STREAM_DRAW, round, d);
+            const int multiplier = options.multiplier ? drawMultiplier<Game>(seed, round, d) : 1;
+            draws.push_back(Draw<Game>{winning, multiplier, false, PrizeTable<Game>(jackpot, multiplier)});
+            labels.push_back(label + ": ");
+            if constexpr (Game::doublePlay){
+                if(options.doublePlay){
+                    generateTicket(winning, sampler, seed, STREAM_DOUBLE_PLAY, round, d);
+                    draws.push_back(Draw<Game>{winning, 1, true, PrizeTable<Game>(jackpot, 1, Game::doublePlayPrizes)});
+                    labels.push_back(label + ", Double Play: ");
+                }
+            }
+        }
+        MultiDrawTally round_tally;
+        OrderedOutput listing_out(out);
+
+        runParallel(plays, threads, [&](int worker, long long first, long long count, MultiDrawTally &tally){
+            WhiteBallSampler<Game> worker_sampler;
+            Ticket<Game> block[TICKET_BLOCK];
+            OutputBuffer text;
+
+            tally.draws.assign(draws.size(), SimTally());
+            if(!indexes.empty()){
+                for(size_t d=0; d<draws.size(); d++)
+                    indexes[worker].score(draws[d].winning.white, draws[d].winning.bonus, tally.draws[d]);
+                return;
+            }
+            long long end, step;
+            workerBlocks(plays, workers, worker, count, listing, first, end, step);
+            for(long long i=first; i<end; i+=step){
+                int n = (int)std::min<long long>(TICKET_BLOCK, end - i);
+                const Ticket<Game>* tickets = block;
+                if(!pool.empty())
+                    tickets = &pool[i];
+                else
+                    generateQuickPicks(block, n, worker_sampler, seed, round, i);
+                scoreTickets(tickets, n, draws, tally);
+                if(listing){
+                    listTickets(tickets, n, draws, labels, options.output == OUTPUT_WINNERS, text);
+                    listing_out.write(i / TICKET_BLOCK, text);
+                }
+            }
+        }, round_tally);
+
+        for(size_t d=0; d<draws.size(); d++){
+            SimTally &draw_tally = round_tally.draws[d];
+            draw_tally.settle(draws[d].prizes);
+            if(draws[d].doublePlay)
+                double_play_total.add(draw_tally);
+            else{
+                total.add(draw_tally);
+                histogram.addDraw(draws[d].multiplier, draw_tally);
+            }
+            if(options.targetCi > 0.0){
+                if(options.ticketFile.empty())
+                    addTierValues<Game>(draw_tally, tier_returns[draws[d].doublePlay], returns[draws[d].doublePlay]);
+                else
+                    returns[draws[d].doublePlay].add((double)draw_tally.total_winnings / ticket_price / plays);
+            }
+
+            if(options.output >= OUTPUT_ROUNDS){
+                writeDrawLine(out, draws[d].doublePlay ? "  Double Play: " : labels[d], draws[d],
+                              draw_tally.total_winnings);
+                out.put('\n');
+            }
+        }
+        rounds_played = round;
+        if(options.targetCi > 0.0)
+            converged = returns[0].count >= MIN_CONVERGENCE_SAMPLES
+                && 2 * returnHalfWidth(returns) <= options.targetCi
+                && tiersConverged(histogram, options.tierCi);
+    }
+    out.flush();
+
+    Money total_winnings = total.total_winnings;
+    bool overflow = total.overflow || double_play_total.overflow;
+    if(!addMoney(total_winnings, double_play_total.total_winnings))
+        overflow = true;
+    Money cost;
+    if(!multiplyMoney(total.tickets, ticket_price, cost))
+        overflow = true;
+    if(overflow)
+        std::cerr << "Warning: dollar totals exceed $" << formatWithCommas(MONEY_MAX) << " and are capped" << std::endl;
+
+    std::cout << "\n" << Game::title << " batch results\n"
+        << "Seed:               " << seed << "\n"
+        << "Threads:            " << threads << "\n";
+    if(!options.ticketFile.empty())
+        std::cout << "Ticket File:        " << options.ticketFile << " (" << formatWithCommas(plays) << " tickets)\n";
+    std::cout << "Jackpot:            $" << formatWithCommas(jackpot) << "\n"
+        << "Draws:              " << formatWithCommas(rounds_played * options.draws) << "\n";
+    if(options.draws > 1)
+        std::cout << "Draws per Ticket:   " << formatWithCommas(options.draws) << "\n";
+    std::cout << "Tickets:            " << formatWithCommas(total.tickets) << "\n"
+        << "Price of Tickets:   $" << formatWithCommas(cost) << "\n"
+        << "Total Winnings:     $" << formatWithCommas(total_winnings) << "\n";
+    if(options.doublePlay)
+        std::cout << "Double Play Wins:   $" << formatWithCommas(double_play_total.total_winnings)
+            << " on " << formatWithCommas(double_play_total.winning_tickets) << " tickets\n";
+    std::cout << "Winning Tickets:    " << formatWithCommas(total.winning_tickets) << "\n"
+        << "Jackpots Won:       " << formatWithCommas(total.hits[Game::picks][Game::bonusPool > 0]) << "\n";
+    if(cost > 0)
+        std::cout << "Return per $1:      $" << (double)total_winnings / cost << "\n";
+    if(options.targetCi > 0.0)
+        std::cout << "95% CI:             $" << returns[0].mean + returns[1].mean
+            << " +/- " << returnHalfWidth(returns) << "\n"
+            << "Converged:          " << (converged ? "yes" : "no") << ", after "
+            << formatWithCommas(rounds_played) << " rounds\n";
+    std::cout << "Expected per $1:    $"
+        << expectedWinnings<Game>(jackpot, options.multiplier, options.doublePlay) / ticket_price << "\n";
+    std::cout << "\n";
+    printTierTable(histogram, std::cout);
+    std::cout << std::endl;
+    return 0;
+}
+
+// Build a ticket matching exactly matching_white of the winning white balls,
+// and the winning bonus ball if and only if matchesBonus, otherwise at
+// random: a quick pick conditioned on landing in that tier
+template<class Game, class Generator>
+void generateTierTicket(Ticket<Game> &ticket, const Ticket<Game> &winning, int matching_white, bool matchesBonus,
+                        Generator &gen){
+    int drawn[Game::picks];
+    int count = 0;
+    forEachBall(winning.white, [&](int ball){ drawn[count++] = ball; });
+
+    ticket.white.clear();
+    for(int i=0; i<matching_white; i++){
+        int j = i + (int)boundedRandom(gen, Game::picks - i);
+        std::swap(drawn[i], drawn[j]);
+        ticket.white.set(drawn[i]);
+    }
+    // The other numbers come from the balls not drawn, most of the pool
+    for(int i=matching_white; i<Game::picks; ){
+        int ball = 1 + (int)boundedRandom(gen, Game::whitePool);
+        if(winning.white.test(ball) || ticket.white.test(ball))
+            continue;
+        ticket.white.set(ball);
+        i++;
+    }
+
+    ticket.bonus = 0;
+    if constexpr (Game::bonusPool > 0){
+        if(matchesBonus)
+            ticket.bonus = winning.bonus;
+        else{
+            int bonus = 1 + (int)boundedRandom(gen, Game::bonusPool - 1);
+            ticket.bonus = bonus >= winning.bonus ? bonus + 1 : bonus;
+        }
+    }
+}
+
+// Headless run estimating the return and tier odds by importance sampling:
+// instead of uniform quick picks, each ticket's [white matches][bonus
+// matched] tier is chosen uniformly and the ticket built to land in it, so
+// the jackpot and second tiers are sampled as often as losing tickets. Each
+// sample is then weighted by its tier's exact probability over its proposal
+// probability, which keeps the estimates unbiased. With the multiplier each
+// tier pays its mean prize over the multipliers: one multiplier drawn per
+// draw would be shared by all of its samples and dominate the variance.
+// Plays options.rounds
+// draws of options.plays tickets (or until options.targetCi is met) and
+// prints the estimates beside the exact odds and expected value from
+// gameOdds.h. Returns the process exit code.
+template<class Game>
+int runImportance(const SimOptions &options, Money jackpot){
+    constexpr int BONUS_CELLS = Game::bonusPool > 0 ? 2 : 1;
+    constexpr int CELLS = (Game::picks + 1) * BONUS_CELLS;
+    const unsigned long long seed = resolveSeed(options);
+    const int threads = resolveThreads(options);
+    const int ticket_price = Game::ticketPrice + (options.multiplier ? Game::multiplierPrice : 0);
+    WhiteBallSampler<Game> sampler;
+    TierHistogram<Game> histogram;
+    OutputBuffer out(stdout);
+
+    // Weight of each tier's samples, and their weighted return per $1
+    double weights[Game::picks + 1][2] = {};
+    double value[Game::picks + 1][2] = {};
+    double jackpot_value[Game::picks + 1][2] = {};
+    for(int white=0; white<=Game::picks; white++)
+        for(int bonus=0; bonus<BONUS_CELLS; bonus++){
+            weights[white][bonus] = tierProbability<Game>(white, bonus) * CELLS;
+            value[white][bonus] = weights[white][bonus] / ticket_price
+                * expectedTierPrize<Game>(jackpot, options.multiplier, white, bonus);
+        }
+    jackpot_value[Game::picks][BONUS_CELLS - 1] = value[Game::picks][BONUS_CELLS - 1];
+
+    RunningStats returns;
+    RunningStats jackpot_returns;       // The jackpot tier's share of returns
+    long long rounds_played = 0;
+    bool converged = false;
+
+    for(long long round=1; round<=options.rounds && !converged; round++){
+        Ticket<Game> winning;
+        generateTicket(winning, sampler, seed, STREAM_DRAW, round, 0);
+        const std::vector<Draw<Game> > draws = {Draw<Game>{winning, 1, false, PrizeTable<Game>(jackpot, 1)}};
+        MultiDrawTally round_tally;
+
+        runParallel(options.plays, threads, [&](int, long long first, long long count, MultiDrawTally &tally){
+            Ticket<Game> block[TICKET_BLOCK];
+
+            tally.draws.assign(1, SimTally());
+            for(long long i=first; i<first + count; i+=TICKET_BLOCK){
+                int n = (int)std::min<long long>(TICKET_BLOCK, first + count - i);
+                for(int j=0; j<n; j++){
+                    PhiloxStream random(seed, STREAM_TIER, round, i + j);
+                    int cell = (int)boundedRandom(random, CELLS);
+                    generateTierTicket(block[j], winning, cell / BONUS_CELLS, cell % BONUS_CELLS, random);
+                }
+                scoreTickets(block, n, draws, tally);
+            }
+        }, round_tally);
+
+        const SimTally &draw_tally = round_tally.draws[0];
+        histogram.addDraw(1, draw_tally);
+        addTierValues<Game>(draw_tally, value, returns);
+        addTierValues<Game>(draw_tally, jackpot_value, jackpot_returns);
+
+        if(options.output >= OUTPUT_ROUNDS){
+            out.put("Round ");
+            out.number(round);
+            out.put(": ");
+            writeWinningNumbers(out, winning);
+            out.put("Return per $1: $");
+            out.put(std::to_string(returns.mean));
+            out.put(" +/- ");
+            out.put(std::to_string(returns.halfWidth()));
+            out.put('\n');
+        }
+        rounds_played = round;
+        if(options.targetCi > 0.0)
+            converged = returns.count >= MIN_CONVERGENCE_SAMPLES && 2 * returns.halfWidth() <= options.targetCi;
+    }
+    out.flush();
+
+    const long long samples = histogram.totalTickets();
+    const double expected = expectedWinnings<Game>(jackpot, options.multiplier) / ticket_price;
+    const double expected_jackpot = tierProbability<Game>(Game::picks, Game::bonusPool > 0)
+        * expectedTierPrize<Game>(jackpot, options.multiplier, Game::picks, Game::bonusPool > 0) / ticket_price;
+
+    std::cout << "\n" << Game::title << " importance sampling\n"
+        << "Seed:               " << seed << "\n"
+        << "Threads:            " << threads << "\n"
+        << "Jackpot:            $" << formatWithCommas(jackpot) << "\n"
+        << "Draws:              " << formatWithCommas(rounds_played) << "\n"
+        << "Samples:            " << formatWithCommas(samples) << "\n"
+        << "Return per $1:      $" << returns.mean << " +/- " << returns.halfWidth() << " (95% CI)\n"
+        << "Expected per $1:    $" << expected << " (exact)\n"
+        << "Jackpot Share:      $" << jackpot_returns.mean << " +/- " << jackpot_returns.halfWidth()
+        << " (exact $" << expected_jackpot << ")\n";
+    if(options.targetCi > 0.0)
+        std::cout << "Converged:          " << (converged ? "yes" : "no") << ", after "
+            << formatWithCommas(rounds_played) << " rounds\n";
+
+    // Each sample of a tier stands for weight tickets of a uniform run
+    std::cout << "\n" << std::left << std::setw(16) << "Tier" << std::right << std::setw(14) << "Samples"
+        << std::setw(14) << "Weight" << std::setw(20) << "Estimated" << std::setw(20) << "Exact"
+        << std::setw(12) << "Error" << "\n";
+    for(int white=Game::picks; white>=0; white--)
+        for(int bonus=BONUS_CELLS - 1; bonus>=0; bonus--){
+            std::string tier = std::to_string(white);
+            if(bonus)
+                tier += std::string(" + ") + Game::bonusName;
+            long long hits = histogram.totalHits(white, bonus);
+            double exact = tierProbability<Game>(white, bonus);
+            double estimate = samples > 0 ? hits * weights[white][bonus] / samples : 0.0;
+            std::ostringstream weight_text, error_text;
+            weight_text << std::setprecision(4) << weights[white][bonus];
+            error_text << std::fixed << std::setprecision(2) << (estimate / exact - 1.0) * 100 << "%";
+            std::cout << std::left << std::setw(16) << tier << std::right << std::setw(14) << formatWithCommas(hits)
+                << std::setw(14) << weight_text.str() << std::setw(20) << formatOdds(estimate)
+                << std::setw(20) << formatOdds(exact) << std::setw(12) << error_text.str() << "\n";
+        }
+    std::cout << std::endl;
+    return 0;
+}
+
+// Replay the tickets in options.ticketFile against every draw in
+// options.historyFile, in file order, as one round: each draw's own
+// multiplier (with options.multiplier) and jackpot set its prizes; draws
+// without a jackpot use jackpot, which must then be given. Prints a line per draw and the tickets
+// options.output asks for, then totals. Returns the process exit code.
+template<class Game>
+int runHistory(const SimOptions &options, Money jackpot){
+    const int threads = resolveThreads(options);
+    const int ticket_price = Game::ticketPrice + (options.multiplier ? Game::multiplierPrice : 0);
+    const TicketRules rules = {Game::whitePool, Game::bonusPool};
+    std::vector<HistoricalDraw> history;
+    std::vector<Ticket<Game> > pool;
+    std::vector<Draw<Game> > draws;
+    std::vector<std::string> labels;
+    std::string error;
+    OutputBuffer out(stdout);
+    const bool listing = options.output >= OUTPUT_WINNERS;
+
+    if(!loadHistoryFile(options.historyFile, rules, history, error)){
+        std::cerr << "Failed to load draw history: " << error << std::endl;
+        return 1;
+    }
+    if((long long)history.size() > MAX_DRAWS){
+        std::cerr << "Draw history has more than " << formatWithCommas(MAX_DRAWS) << " draws" << std::endl;
+        return 1;
+    }
+    for(size_t d=0; d<history.size(); d++){
+        const HistoricalDraw &entry = history[d];
+        if(options.multiplier && TierHistogram<Game>::slot(entry.multiplier) == 0 && entry.multiplier != 1){
+            std::cerr << "Failed to load draw history: " << options.historyFile << ": draw " << entry.date
+                << ": " << Game::multiplierName << " " << entry.multiplier << " is not offered" << std::endl;
+            return 1;
+        }
+        if(entry.jackpot <= 0 && jackpot <= 0){
+            std::cerr << "Draw " << entry.date << " in " << options.historyFile
+                << " has no jackpot; pass --jackpot N to use for draws without one" << std::endl;
+            return 1;
+        }
+        const int multiplier = options.multiplier ? entry.multiplier : 1;
+        const Money draw_jackpot = entry.jackpot > 0 ? entry.jackpot : jackpot;
+        draws.push_back(Draw<Game>{ticketFromNumbers<Game>(entry.balls), multiplier, false,
+                                   PrizeTable<Game>(draw_jackpot, multiplier)});
+        labels.push_back(std::string(entry.date) + ": ");
+    }
+
+    if(!loadTicketFile(options.ticketFile, rules, threads, ticketFromNumbers<Game>, pool, error)){
+        std::cerr << "Failed to load tickets: " << error << std::endl;
+        return 1;
+    }
+    const long long plays = (long long)pool.size();
+    std::vector<TicketIndex<Game::whitePool, Game::bonusPool> > indexes;
+    if(!listing)
+        indexTicketPool(pool, (long long)draws.size(), threads, indexes);
+
+    const int workers = parallelWorkers(plays, threads);
+
+    MultiDrawTally replay;
+    OrderedOutput listing_out(out);
+    runParallel(plays, threads, [&](int worker, long long first, long long count, MultiDrawTally &tally){
+        OutputBuffer text;
+        tally.draws.assign(draws.size(), SimTally());
+        if(!indexes.empty()){
+            for(size_t d=0; d<draws.size(); d++)
+                indexes[worker].score(draws[d].winning.white, draws[d].winning.bonus, tally.draws[d]);
+            return;
+        }
+        long long end, step;
+        workerBlocks(plays, workers, worker, count, listing, first, end, step);
+        for(long long i=first; i<end; i+=step){
+            int n = (int)std::min<long long>(TICKET_BLOCK, end - i);
+            scoreTickets(&pool[i], n, draws, tally);
+            if(listing){
+                listTickets(&pool[i], n, draws, labels, options.output == OUTPUT_WINNERS, text);
+                listing_out.write(i / TICKET_BLOCK, text);
+            }
+        }
+    }, replay);
+
+    SimTally total;
+    TierHistogram<Game> histogram;
+    for(size_t d=0; d<draws.size(); d++){
+        SimTally &draw_tally = replay.draws[d];
+        draw_tally.settle(draws[d].prizes);
+        total.add(draw_tally);
+        histogram.addDraw(draws[d].multiplier, draw_tally);
+
+        if(options.output >= OUTPUT_ROUNDS){
+            writeDrawLine(out, labels[d], draws[d], draw_tally.total_winnings);
+            out.put("\tTotal: $");
+            out.withCommas(total.total_winnings);
+            out.put('\n');
+        }
+    }
+    out.flush();
+
+    Money cost;
+    bool overflow = total.overflow;
+    if(!multiplyMoney(total.tickets, ticket_price, cost))
+        overflow = true;
+    if(overflow)
+        std::cerr << "Warning: dollar totals exceed $" << formatWithCommas(MONEY_MAX) << " and are capped" << std::endl;
+
+    std::cout << "\n" << Game::title << " history replay\n"
+        << "Threads:            " << threads << "\n"
+        << "Ticket File:        " << options.ticketFile << " (" << formatWithCommas(plays) << " tickets)\n"
+        << "History File:       " << options.historyFile << "\n"
+        << "Draws:              " << formatWithCommas((long long)draws.size())
+        << " (" << history.front().date << " to " << history.back().date << ")\n"
+        << "Tickets:            " << formatWithCommas(total.tickets) << "\n"
+        << "Price of Tickets:   $" << formatWithCommas(cost) << "\n"
+        << "Total Winnings:     $" << formatWithCommas(total.total_winnings) << "\n"
+        << "Winning Tickets:    " << formatWithCommas(total.winning_tickets) << "\n"
+        << "Jackpots Won:       " << formatWithCommas(total.hits[Game::picks][Game::bonusPool > 0]) << "\n";
+    if(cost > 0)
+        std::cout << "Return per $1:      $" << (double)total.total_winnings / cost << "\n";
+    std::cout << "\n";
+    printTierTable(histogram, std::cout);
+    std::cout << std::endl;
+    return 0;
+}
+
+// Regenerate quick pick options.ticketIndex of round options.ticketRound of
+// the run with options.seed, without generating any other ticket, and print
+// it against each draw of that round. Returns the process exit code.
+template<class Game>
+int printTicketAt(const SimOptions &options){
+    const unsigned long long seed = resolveSeed(options);
+    const long long round = options.ticketRound;
+    WhiteBallSampler<Game> sampler;
+    Ticket<Game> ticket;
+    OutputBuffer out(stdout);
+
+    generateTicket(ticket, sampler, seed, STREAM_TICKET, round, options.ticketIndex);
+    std::cout << "Seed: " << seed << std::endl;
+    for(long long d=0; d<options.draws; d++){
+        for(int double_play=0; double_play<=(options.doublePlay ? 1 : 0); double_play++){
+            Ticket<Game> winning;
+            generateTicket(winning, sampler, seed, double_play ? STREAM_DOUBLE_PLAY : STREAM_DRAW, round, d);
+            const int multiplier = options.multiplier && !double_play ? drawMultiplier<Game>(seed, round, d) : 1;
+            // Without --jackpot the jackpot tier pays 0, so a jackpot hit
+            // shows its matches without an amount
+            Money winnings = 0;
+            if constexpr (Game::doublePlay){
+                if(double_play)
+                    winnings = playPrize(ticket, winning, PrizeTable<Game>(options.jackpot, 1, Game::doublePlayPrizes));
+            }
+            if(!double_play)
+                winnings = playPrize(ticket, winning, PrizeTable<Game>(options.jackpot, multiplier));
+            out.put("Round ");
+            out.number(round);
+            if(options.draws > 1){
+                out.put(", Draw ");
+                out.number(d + 1);
+            }
+            out.put(double_play ? ", Double Play: " : ": ");
+            writeWinningNumbers(out, winning);
+            if(options.multiplier && !double_play){
+                out.put(Game::multiplierLabel);
+                out.number(multiplier);
+            }
+            out.put("\n  Ticket ");
+            out.withCommas(options.ticketIndex);
+            out.put(": ");
+            writeTicketLine(out, ticket, winning, winnings);
+        }
+    }
+    return 0;
+}
+
+template<class Game>
+int runSimulation(const SimOptions &options, Money jackpot){
+    return options.importance ? runImportance<Game>(options, jackpot) : runBatch<Game>(options, jackpot);
+}
+
+// Prompt-driven game: pick or generate tickets, draw, print results, repeat
+template<class Game>
+void playInteractive(const SimOptions &options, Money jackpot, const std::string &jackpot_string,
+                     const std::string &next_draw_date){
+    Ticket<Game> winning;
+    WhiteBallSampler<Game> sampler;
+    const unsigned long long seed = resolveSeed(options);
+    long long game = 0;     // Numbers each game like a batch round
+    int play_opt;
+    int num_of_plays;
+    char addMultiplier;
+    int multiplier = 1;
+    Money total_winnings = 0;
+    char playAgain;
+    OutputBuffer out(stdout);   // Ticket lines; flushed before anything else is printed
+
+    do{
+        total_winnings = 0;
+        game++;
+
+        std::cout << "\n\n\n" << Game::title << "\n\nNext Draw: " << next_draw_date << " " << Game::drawTime
+            << "\nESTIMATED JACKPOT: " << jackpot_string << std::endl;
+
+        //Generate random winning numbers
+        generateTicket(winning, sampler, seed, STREAM_DRAW, game, 0);
+
+        while (std::cout << "(1) Quick pick\n(2) Pick my own numbers" << std::endl && ((!(std::cin >> play_opt))
+                || (play_opt != 1 && play_opt != 2))) {
+        std::cin.clear(); //clear bad input flag
+        std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n'); //discard input
+        std::cout << "\nInvalid input\n";
+        }
+
+        while (std::cout << "\nHow many plays?" << std::endl && !(std::cin >> num_of_plays)) {
+        std::cin.clear(); //clear bad input flag
+        std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n'); //discard input
+        std::cout << "\nInvalid input\n";
+        }
+
+        do{
+            std::cout << "\nWould you like to add " << Game::multiplierName << "? (y/n)" << std::endl;
+            std::cin >> addMultiplier;
+            if(addMultiplier != 'y' && addMultiplier != 'Y' &&
+                addMultiplier != 'n' && addMultiplier != 'N')
+                std::cout << "\nInvalid input\n" << std::endl;
+            else if(addMultiplier == 'y' || addMultiplier == 'Y')
+                multiplier = drawMultiplier<Game>(seed, game, 0);
+            else
+                multiplier = 1;
+        }
+        while(addMultiplier != 'y' && addMultiplier != 'Y' &&
+                addMultiplier != 'n' && addMultiplier != 'N');
+
+        const PrizeTable<Game> prizes(jackpot, multiplier);
+
+        //Quick Pick
+        if (play_opt == 1){
+
+            std::cout << "\n\nYour Tickets:\n" << std::endl;
+
+            for(int i=1; i<=num_of_plays; i++){
+                Ticket<Game> ticket;
+
+                generateTicket(ticket, sampler, seed, STREAM_TICKET, game, i - 1);
+                total_winnings += playTicket(out, ticket, winning, prizes);
+            }
+            out.flush();
+        }
+
+        //User picks their own numbers
+        else{
+            TicketStore<Ticket<Game> > tickets;
+
+            for(int i=1; i<=num_of_plays; i++){
+                Ticket<Game> ticket;
+
+                std::cout << "\n\nTICKET #" << i << "\n----------\n" << std::endl;
+                readTicket(ticket);
+
+                //Print and score entered tickets a chunk at a time, so memory stays bounded
+                tickets.add(ticket);
+                if(tickets.full() || i == num_of_plays){
+                    if(tickets.scored() == 0)
+                        std::cout << "\n\nYour Tickets:\n" << std::endl;
+                    tickets.flush([&](const Ticket<Game> &entered){
+                        total_winnings += playTicket(out, entered, winning, prizes);
+                    });
+                    out.flush();
+                }
+            }
+        }
+
+        //Print price of tickets
+        int ticket_price = Game::ticketPrice + (multiplier > 1 ? Game::multiplierPrice : 0);
+        std::cout << "\n\nPrice of Tickets: $" << formatWithCommas((Money)ticket_price * num_of_plays) << std::endl;
+
+        //Print the winning numbers
+        std::cout << "\n\nWinning Numbers:\n" << std::endl;
+        writeWinningNumbers(out, winning);
+        out.put('\n');
+        out.flush();
+
+        if(multiplier > 1)
+            std::cout << "\n" << Game::multiplierLabel << multiplier << std::endl;
+
+        if(total_winnings >= jackpot)
+            std::cout << "\n\n\n*** CONGRATULATIONS - YOU WON THE JACKPOT! ***\n\nYour Winnings: $" << formatWithCommas(total_winnings) << std::endl;
+
+        else if (total_winnings > 0)
+            std::cout << "\n\n\n*  Your Winnings: $" << formatWithCommas(total_winnings) << "  *" << std::endl;
+
+        else
+            std::cout << "\n\n\nSorry, you didn't win this time." << std::endl;
+
+        std::cout << "\n\n" << std::endl;
+
+        do{
+            std::cout << "\nPlay again? (y/n)" << std::endl;
+            std::cin >> playAgain;
+            if(playAgain != 'y' && playAgain != 'Y' &&
+                playAgain != 'n' && playAgain != 'N')
+                std::cout << "\nInvalid input\n" << std::endl;
+        }
+        while(playAgain != 'y' && playAgain != 'Y' &&
+                playAgain != 'n' && playAgain != 'N');
+
+    }while(playAgain == 'y' || playAgain == 'Y');
+}
+
+// Page to fetch a game's data from: --data-url or LOTTERY_DATA_URL if set
+// (unless pageOverride is false), otherwise the game's lotteryusa.com page,
+// moved to --base-url or LOTTERY_BASE_URL if set
+template<class Game>
+std::string gameDataUrl(const SimOptions &options, bool pageOverride = true){
+    const char* env_url = std::getenv("LOTTERY_DATA_URL");
+    if (pageOverride && !options.dataUrl.empty())
+        return options.dataUrl;
+    if (pageOverride && env_url != nullptr && *env_url != '\0')
+        return env_url;
+
+    std::string base = options.baseUrl;
+    const char* env_base = std::getenv("LOTTERY_BASE_URL");
+    if (base.empty() && env_base != nullptr)
+        base = env_base;
+    return base.empty() ? std::string(Game::url) : rebaseUrl(Game::url, base);
+}
+
+inline FetchPolicy fetchPolicyFor(const SimOptions &options){
+    FetchPolicy policy;
+    policy.connectTimeoutMs = (long)options.connectTimeout * 1000;
+    policy.totalTimeoutMs = (long)options.fetchTimeout * 1000;
+    policy.maxAttempts = (int)options.fetchAttempts;
+    return policy;
+}
+
+// Ask for the jackpot when it cannot be fetched; returns 0 if none is given
+inline Money readJackpot(){
+    long long jackpot = 0;
+    std::cout << "Enter the jackpot in dollars (0 to quit):" << std::endl;
+    while (!(std::cin >> jackpot) || jackpot < 0){
+        if (std::cin.eof())
+            return 0;
+        std::cin.clear(); //clear bad input flag
+        std::cin.ignore(std::numeric_limits<std::streamsize>::max(), '\n'); //discard input
+        std::cout << "\nInvalid input\n";
+    }
+    return jackpot;
+}
+
+// Fetch every game's data at once and store it in the cache, so the next run
+// of each game starts without a fetch. Returns the process exit code.
+inline int refreshAllGames(const SimOptions &options){
+    const char* titles[] = {PowerballGame::title, MegaMillionsGame::title, JerseyCash5Game::title};
+    const char* cache_names[] = {PowerballGame::cacheName, MegaMillionsGame::cacheName, JerseyCash5Game::cacheName};
+    std::vector<std::string> urls = {gameDataUrl<PowerballGame>(options, false),
+                                     gameDataUrl<MegaMillionsGame>(options, false),
+                                     gameDataUrl<JerseyCash5Game>(options, false)};
+    int exitCode = 0;
+
+    std::vector<GameDataStruct> games = fetchGameDataConcurrently(urls, fetchPolicyFor(options));
+    for (size_t i = 0; i < games.size(); i++){
+        if (games[i].currentJackpot.empty()){
+            std::cerr << "Failed to fetch jackpot for " << titles[i] << std::endl;
+            exitCode = 1;
+            continue;
+        }
+        if (options.cacheTtl > 0)
+            writeCachedGameData(cache_names[i], urls[i], games[i]);
+        std::string next_draw_date = games[i].nextDrawDate;
+        removeLeadingTrailingSpaces(next_draw_date);
+        std::cout << titles[i] << ": " << games[i].currentJackpot << ", next draw " << next_draw_date << std::endl;
+    }
+    return exitCode;
+}
+
+// Entry point shared by the game executables
+template<class Game>
+int runGame(int argc, char* argv[]){
+    SimOptions options;
+    int exitCode;
+
+    if (!parseSimOptions(argc, argv, Game::multiplierName, options, exitCode))
+        return exitCode;
+
+    if (options.refreshAll)
+        return refreshAllGames(options);
+
+    if (options.doublePlay && !Game::doublePlay){
+        std::cerr << Game::title << " has no Double Play" << std::endl;
+        return 1;
+    }
+
+    // A ticket pool plays every ticket it holds in every draw
+    if (!options.ticketFile.empty() && options.playsGiven){
+        std::cerr << "--plays sets the number of quick picks; with --tickets every ticket in the file is played"
+            << std::endl;
+        return 1;
+    }
+
+    // Replays use each draw's own jackpot, or --jackpot for draws without
+    // one, so there is nothing to fetch
+    if (!options.historyFile.empty()){
+        if (options.ticketFile.empty() || options.doublePlay || options.draws > 1 || options.odds
+                || options.targetCi > 0.0 || options.tierCi > 0.0 || options.importance || options.roundsGiven
+                || options.ticketIndex >= 0){
+            std::cerr << "--history replays a --tickets file once against every draw in the file, without"
+                " --double-play, --draws, --rounds, --odds, --target-ci, --tier-ci, --importance or --ticket-index"
+                << std::endl;
+            return 1;
+        }
+        return runHistory<Game>(options, options.jackpot);
+    }
+
+    if (options.ticketIndex >= 0){
+        if (!options.ticketFile.empty() || options.importance){
+            std::cerr << "--ticket-index regenerates a quick pick, without --tickets or --importance"
+                << std::endl;
+            return 1;
+        }
+        return printTicketAt<Game>(options);
+    }
+
+    if (options.tierCi > 0.0 && options.targetCi <= 0.0){
+        std::cerr << "--tier-ci needs --target-ci" << std::endl;
+        return 1;
+    }
+
+    if (options.odds && options.jackpot > 0){
+        printOdds<Game>(options.jackpot, options.multiplier, std::cout, options.doublePlay);
+        return 0;
+    }
+    if (options.importance && (!options.ticketFile.empty() || options.doublePlay || options.draws > 1
+            || options.tierCi > 0.0 || options.output >= OUTPUT_WINNERS)){
+        std::cerr << "--importance samples quick picks in single draws, without --tickets, --double-play,"
+            " --draws, --tier-ci or ticket listings" << std::endl;
+        return 1;
+    }
+
+    if (options.batch && options.jackpot > 0)
+        return runSimulation<Game>(options, options.jackpot);
+
+    GameDataStruct gameData = loadGameData(Game::cacheName, gameDataUrl<Game>(options), options.cacheTtl,
+                                           fetchPolicyFor(options));
+    std::string jackpot_string = gameData.currentJackpot;
+    std::string next_draw_date = gameData.nextDrawDate;
+    Money jackpot = 0;
+
+    if (jackpot_string == ""){
+        std::cout << "Failed to fetch jackpot." << std::endl;
+        if (options.batch){
+            std::cerr << "Pass --jackpot N to run without fetching." << std::endl;
+            return 1;
+        }
+        jackpot = readJackpot();
+        if (jackpot == 0)
+            return 1;
+        jackpot_string = "$" + formatWithCommas(jackpot);
+    }
+    else
+        jackpot = jackpotFromString(jackpot_string, Game::jackpotUnit);
+
+    if (next_draw_date == ""){
+        std::cout << "Failed to fetch next draw date." << std::endl;
+    }
+
+    removeLeadingTrailingSpaces(next_draw_date);
+
+    if (options.odds){
+        printOdds<Game>(jackpot, options.multiplier, std::cout, options.doublePlay);
+        return 0;
+    }
+    if (options.batch)
+        return runSimulation<Game>(options, jackpot);
+
+    playInteractive<Game>(options, jackpot, jackpot_string, next_draw_date);
+    return 0;
+}
+
+#endif
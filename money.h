@@ -0,0 +1,30 @@
+#ifndef MONEY_H
+#define MONEY_H
+
+#include <limits>
+
+// Dollar amounts: jackpots, prizes, ticket costs and run totals. 64-bit, since
+// billion-dollar jackpots and the totals of large runs do not fit in an int.
+typedef long long Money;
+
+const Money MONEY_MAX = std::numeric_limits<Money>::max();
+
+// total += amount, saturating at MONEY_MAX; returns false if it overflowed
+inline bool addMoney(Money &total, Money amount){
+    if(__builtin_add_overflow(total, amount, &total)){
+        total = MONEY_MAX;
+        return false;
+    }
+    return true;
+}
+
+// count * amount, saturating at MONEY_MAX; returns false if it overflowed
+inline bool multiplyMoney(long long count, Money amount, Money &result){
+    if(__builtin_mul_overflow(count, amount, &result)){
+        result = MONEY_MAX;
+        return false;
+    }
+    return true;
+}
+
+#endif
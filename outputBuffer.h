@@ -0,0 +1,125 @@
+#ifndef OUTPUT_BUFFER_H
+#define OUTPUT_BUFFER_H
+
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include "textUtils.h"
+
+// Text output collected in memory and written in large pieces, instead of a
+// stream insertion and flush per ticket line. A buffer for a file writes
+// itself out whenever FLUSH_BYTES are pending and when destroyed; a buffer
+// without one (as each worker thread keeps) grows until writeTo() is called,
+// so the lines of several threads can be written in order (see OrderedOutput).
+class OutputBuffer
+{
+public:
+    static const size_t FLUSH_BYTES = 1 << 16;
+
+    explicit OutputBuffer(FILE* file = nullptr) : file(file){
+        text.reserve(FLUSH_BYTES + 256);
+    }
+
+    ~OutputBuffer(){
+        flush();
+    }
+
+    void put(char c){
+        text.push_back(c);
+        if(file != nullptr && text.size() >= FLUSH_BYTES)
+            flush();
+    }
+
+    void put(const char* s){
+        put(s, std::strlen(s));
+    }
+
+    void put(const char* s, size_t length){
+        text.append(s, length);
+        if(file != nullptr && text.size() >= FLUSH_BYTES)
+            flush();
+    }
+
+    void put(const std::string &s){
+        put(s.data(), s.size());
+    }
+
+    // A number without commas
+    void number(long long value){
+        char digits[24];
+        char* end = digits + sizeof(digits);
+        char* p = end;
+        unsigned long long magnitude = value < 0 ? 0ULL - (unsigned long long)value : (unsigned long long)value;
+        do{
+            *--p = (char)('0' + magnitude % 10);
+            magnitude /= 10;
+        }while(magnitude > 0);
+        if(value < 0)
+            *--p = '-';
+        put(p, end - p);
+    }
+
+    // A number with thousands commas, as formatWithCommas() but allocating nothing
+    void withCommas(long long value){
+        char digits[COMMA_TEXT_SIZE];
+        put(digits, writeWithCommas(digits, value));
+    }
+
+    size_t size() const{
+        return text.size();
+    }
+
+    // Write everything pending to the buffer's file, if it has one
+    void flush(){
+        if(file == nullptr || text.empty())
+            return;
+        std::fwrite(text.data(), 1, text.size(), file);
+        std::fflush(file);
+        text.clear();
+    }
+
+    // Move everything pending to out, in order after what out already holds
+    void writeTo(OutputBuffer &out){
+        out.put(text.data(), text.size());
+        text.clear();
+    }
+
+private:
+    OutputBuffer(const OutputBuffer&);
+    OutputBuffer& operator=(const OutputBuffer&);
+
+    FILE* file;
+    std::string text;
+};
+
+// Pieces of output numbered from 0, produced by several threads and written
+// to one buffer in number order. A thread handing over piece n waits until
+// pieces 0..n-1 are written, so when threads take turns at consecutive
+// pieces each holds at most one piece of text and nothing else queues up.
+class OrderedOutput
+{
+public:
+    explicit OrderedOutput(OutputBuffer &out) : out(out), next(0){}
+
+    // Move everything in text to out as piece number piece
+    void write(long long piece, OutputBuffer &text){
+        std::unique_lock<std::mutex> lock(mutex);
+        turn.wait(lock, [&](){ return next == piece; });
+        text.writeTo(out);
+        next++;
+        turn.notify_all();
+    }
+
+private:
+    OrderedOutput(const OrderedOutput&);
+    OrderedOutput& operator=(const OrderedOutput&);
+
+    OutputBuffer &out;
+    long long next;             // Piece to write next
+    std::mutex mutex;
+    std::condition_variable turn;
+};
+
+#endif
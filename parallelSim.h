@@ -0,0 +1,111 @@
+#ifndef PARALLEL_SIM_H
+#define PARALLEL_SIM_H
+
+#include <thread>
+#include <vector>
+#include "money.h"
+
+// Results of scoring a share of the tickets. Each worker fills its own tally
+// and the tallies are added together once all workers finish. Workers only
+// count hits per prize tier; the winnings of a draw follow from those counts
+// and the draw's prize table (see settle()).
+struct SimTally
+{
+    long long tickets = 0;
+    long long winning_tickets = 0;
+    Money total_winnings = 0;
+    long long hits[6][2] = {};      // hits[white matches][bonus ball matched]
+    bool overflow = false;          // total_winnings saturated at MONEY_MAX
+
+    void record(int matching_white, bool matchesBonus){
+        tickets++;
+        hits[matching_white][matchesBonus]++;
+    }
+
+    // Add the winnings of the hits recorded for one draw, paid from prizes
+    // (a PrizeTable for that draw)
+    template<class Prizes>
+    void settle(const Prizes &prizes){
+        for(int white=0; white<6; white++)
+            for(int bonus=0; bonus<2; bonus++){
+                Money prize = prizes(white, bonus);
+                if(prize != 0){
+                    Money winnings;
+                    winning_tickets += hits[white][bonus];
+                    if(!multiplyMoney(hits[white][bonus], prize, winnings) || !addMoney(total_winnings, winnings))
+                        overflow = true;
+                }
+            }
+    }
+
+    void add(const SimTally &other){
+        tickets += other.tickets;
+        winning_tickets += other.winning_tickets;
+        if(!addMoney(total_winnings, other.total_winnings) || other.overflow)
+            overflow = true;
+        for(int white=0; white<6; white++)
+            for(int bonus=0; bonus<2; bonus++)
+                hits[white][bonus] += other.hits[white][bonus];
+    }
+};
+
+// Tallies of one share of the tickets entered in several draws, one SimTally
+// per draw. A worker sizes its tally before scoring; add() grows to fit.
+struct MultiDrawTally
+{
+    std::vector<SimTally> draws;
+
+    void add(const MultiDrawTally &other){
+        if(draws.size() < other.draws.size())
+            draws.resize(other.draws.size());
+        for(size_t d=0; d<other.draws.size(); d++)
+            draws[d].add(other.draws[d]);
+    }
+};
+
+// Starting a thread costs more than scoring this many tickets
+const long long MIN_PLAYS_PER_THREAD = 1 << 16;
+
+// Number of workers runParallel() splits plays tickets across
+inline int parallelWorkers(long long plays, int threads){
+    long long useful = (plays + MIN_PLAYS_PER_THREAD - 1) / MIN_PLAYS_PER_THREAD;
+    if(threads > useful)
+        threads = useful > 0 ? (int)useful : 1;
+    return threads;
+}
+
+// Tickets first..first+count-1 make up share t of plays split across workers
+inline void workerShare(long long plays, int workers, int t, long long &first, long long &count){
+    long long share = plays / workers;
+    long long extra = plays % workers;
+    first = t * share + (t < extra ? t : extra);
+    count = share + (t < extra ? 1 : 0);
+}
+
+// Split plays across up to threads workers and add their tallies into total.
+// worker(index, first, count, tally) scores tickets first..first+count-1 into
+// tally; the last share runs on the calling thread. Tally is SimTally or
+// MultiDrawTally.
+template<class Worker, class Tally>
+void runParallel(long long plays, int threads, Worker worker, Tally &total){
+    threads = parallelWorkers(plays, threads);
+
+    std::vector<Tally> tallies(threads);
+    std::vector<std::thread> workers;
+    long long first, count;
+
+    for(int t=0; t<threads - 1; t++){
+        workerShare(plays, threads, t, first, count);
+        workers.emplace_back(worker, t, first, count, std::ref(tallies[t]));
+    }
+    int last = threads - 1;
+    workerShare(plays, threads, last, first, count);
+    worker(last, first, count, tallies[last]);
+
+    for(size_t t=0; t<workers.size(); t++)
+        workers[t].join();
+    for(int t=0; t<threads; t++)
+        total.add(tallies[t]);
+}
+
+#endif
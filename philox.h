@@ -0,0 +1,84 @@
+#ifndef PHILOX_H
+#define PHILOX_H
+
+#include <cstdint>
+
+// Philox4x32-10 (Salmon et al., "Parallel Random Numbers: As Easy as 1, 2,
+// 3", SC11): a counter-based generator. Each 128-bit counter and 64-bit key
+// map to four random 32-bit words with no state in between, so any value of
+// a run can be computed directly from its position instead of by replaying
+// a sequence, and threads need no coordination.
+struct Philox4x32
+{
+    static const uint32_t M0 = 0xD2511F53;
+    static const uint32_t M1 = 0xCD9E8D57;
+    static const uint32_t W0 = 0x9E3779B9;     // Key schedule: golden ratio
+    static const uint32_t W1 = 0xBB67AE85;     // and sqrt(3) - 1
+
+    static void block(const uint32_t counter[4], const uint32_t key[2], uint32_t out[4]){
+        uint32_t c0 = counter[0], c1 = counter[1], c2 = counter[2], c3 = counter[3];
+        uint32_t k0 = key[0], k1 = key[1];
+        for(int round=0; round<10; round++){
+            uint64_t p0 = (uint64_t)M0 * c0;
+            uint64_t p1 = (uint64_t)M1 * c2;
+            c0 = (uint32_t)(p1 >> 32) ^ c1 ^ k0;
+            c1 = (uint32_t)p1;
+            c2 = (uint32_t)(p0 >> 32) ^ c3 ^ k1;
+            c3 = (uint32_t)p0;
+            k0 += W0;
+            k1 += W1;
+        }
+        out[0] = c0;
+        out[1] = c1;
+        out[2] = c2;
+        out[3] = c3;
+    }
+};
+
+// The random words of one numbered stream: run seed, purpose (what the
+// numbers are for), round and index (up to 2^56) select it, and its words
+// come from consecutive blocks. Rounds past 2^32 fold into the key, so one
+// seed's streams stay distinct. A 32-bit generator for boundedRandom() and
+// the samplers in quickPick.h; constructing one costs nothing until the
+// first word is taken.
+class PhiloxStream
+{
+public:
+    typedef uint32_t result_type;
+
+    static constexpr uint32_t min(){ return 0; }
+    static constexpr uint32_t max(){ return 0xffffffffu; }
+
+    PhiloxStream(uint64_t seed, uint32_t purpose, uint64_t round, uint64_t index) : used(4){
+        start(seed, purpose, round, index, key, counter);
+    }
+
+    // The key and first counter of a stream, for code that computes the
+    // blocks of several streams at once
+    static void start(uint64_t seed, uint32_t purpose, uint64_t round, uint64_t index,
+                      uint32_t key[2], uint32_t counter[4]){
+        key[0] = (uint32_t)seed;
+        key[1] = (uint32_t)(seed >> 32) ^ (uint32_t)(round >> 32);
+        counter[0] = 0;                                 // Block within the stream
+        counter[1] = (uint32_t)round;
+        counter[2] = (uint32_t)index;
+        counter[3] = (uint32_t)(index >> 32 & 0xffffff) | purpose << 24;
+    }
+
+    uint32_t operator()(){
+        if(used == 4){
+            Philox4x32::block(counter, key, words);
+            counter[0]++;
+            used = 0;
+        }
+        return words[used++];
+    }
+
+private:
+    uint32_t key[2];
+    uint32_t counter[4];
+    uint32_t words[4];
+    int used;
+};
+
+#endif
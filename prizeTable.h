@@ -0,0 +1,54 @@
+#ifndef PRIZE_TABLE_H
+#define PRIZE_TABLE_H
+
+#include "money.h"
+
+// Prize tiers are declared per game as a constexpr table of PrizeRule indexed
+// [white matches][bonus ball matched] (see gameDescriptors.h). Before a draw is
+// scored the rules are resolved against the jackpot and multiplier into a
+// PrizeTable, so scoring a ticket is a single lookup with no branches.
+
+const int JACKPOT = -1;             // PrizeRule::amount: pays the current jackpot
+const int TIMES_MULTIPLIER = -1;    // PrizeRule::withMultiplier: amount x multiplier
+
+struct PrizeRule
+{
+    int amount;             // Prize without the multiplier, or JACKPOT
+    int withMultiplier;     // Prize with the multiplier, or TIMES_MULTIPLIER
+};
+
+inline int tierIndex(int matching_white, bool matchesBonus){
+    return matching_white * 2 + matchesBonus;
+}
+
+// Prizes for one draw, indexed by tierIndex(). rules defaults to the game's
+// main prize rules.
+template<class Game>
+struct PrizeTable
+{
+    static constexpr int TIERS = (Game::picks + 1) * 2;
+    Money prize[TIERS];
+
+    PrizeTable(Money jackpot, int multiplier, const PrizeRule (*rules)[2] = Game::prizes){
+        for(int white=0; white<=Game::picks; white++)
+            for(int bonus=0; bonus<2; bonus++){
+                const PrizeRule &rule = rules[white][bonus];
+                Money amount;
+                if(rule.amount == JACKPOT)
+                    amount = jackpot;
+                else if(multiplier <= 1)
+                    amount = rule.amount;
+                else if(rule.withMultiplier == TIMES_MULTIPLIER)
+                    amount = rule.amount * multiplier;
+                else
+                    amount = rule.withMultiplier;
+                prize[tierIndex(white, bonus)] = amount;
+            }
+    }
+
+    Money operator()(int matching_white, bool matchesBonus) const{
+        return prize[tierIndex(matching_white, matchesBonus)];
+    }
+};
+
+#endif
@@ -0,0 +1,62 @@
+#ifndef QUICK_PICK_H
+#define QUICK_PICK_H
+
+#include <cstdint>
+#include "ballMask.h"
+
+// Uniform integer in [0, range) from a generator returning full 32-bit values.
+// Multiply-shift with rejection of the biased low products (Lemire), so there
+// is no division on the common path.
+template<class Generator>
+inline uint32_t boundedRandom(Generator &gen, uint32_t range){
+    static_assert(Generator::min() == 0 && Generator::max() == 0xffffffffu,
+                  "boundedRandom needs a 32-bit generator");
+    uint64_t product = (uint64_t)(uint32_t)gen() * range;
+    uint32_t low = (uint32_t)product;
+    if(low < range){
+        uint32_t threshold = (0u - range) % range;
+        while(low < threshold){
+            product = (uint64_t)(uint32_t)gen() * range;
+            low = (uint32_t)product;
+        }
+    }
+    return (uint32_t)(product >> 32);
+}
+
+// Draws K distinct balls from 1..N with a partial Fisher-Yates shuffle, then
+// undoes its swaps, so every draw starts from the same pool: a ticket depends
+// only on the numbers the generator gives it, not on the tickets before it.
+// Drawing a ticket allocates nothing and never retries.
+template<int N, int K>
+class QuickPickSampler
+{
+public:
+    QuickPickSampler(){
+        for(int i=0; i<N; i++)
+            pool[i] = (uint8_t)(i + 1);
+    }
+
+    template<class Generator, int MaxBall>
+    void draw(Generator &gen, BallMask<MaxBall> &balls){
+        uint8_t swapped[K];
+        balls.clear();
+        for(int i=0; i<K; i++){
+            int j = i + (int)boundedRandom(gen, N - i);
+            uint8_t ball = pool[j];
+            pool[j] = pool[i];
+            pool[i] = ball;
+            swapped[i] = (uint8_t)j;
+            balls.set(ball);
+        }
+        for(int i=K - 1; i>=0; i--){
+            uint8_t ball = pool[swapped[i]];
+            pool[swapped[i]] = pool[i];
+            pool[i] = ball;
+        }
+    }
+
+private:
+    uint8_t pool[N];
+};
+
+#endif
@@ -0,0 +1,120 @@
+#ifndef QUICK_PICK_BATCH_H
+#define QUICK_PICK_BATCH_H
+
+#include <cstdint>
+#include "cpuFeatures.h"
+#include "philox.h"
+
+// Quick picks eight at a time on x86 CPUs with AVX2, one ticket per 32-bit
+// lane. Each lane computes the same numbers as a PhiloxStream feeding a
+// QuickPickSampler, so batch and single-ticket generation agree exactly:
+//
+//   - the Philox blocks of all eight streams are computed together;
+//   - each word becomes a number below its range with Lemire's multiply-shift,
+//     with no branches; a lane with a word boundedRandom() might reject
+//     (fewer than one ticket in ten million) is flagged for the scalar path
+//     instead;
+//   - the partial Fisher-Yates shuffle is replayed without a pool: the ball
+//     drawn at step i is at position j_i, which earlier swaps moved there
+//     from position k wherever j_i equals j_k, walking k back from i - 1.
+//     Balls come out distinct by construction, with no compare-and-retry.
+//
+// Other CPUs and compilers use the scalar path throughout.
+
+const int QUICK_PICK_LANES = 8;
+
+// The numbers of QUICK_PICK_LANES consecutive streams
+template<int K>
+struct QuickPickLanes
+{
+    uint32_t balls[K + 1][QUICK_PICK_LANES];    // White balls in drawing order, then the bonus ball
+    uint32_t redo;                              // Bit l set: lane l must be drawn by the scalar path
+};
+
+#ifdef SIMD_AVX2
+
+// Full 64-bit products of eight 32-bit lanes, split into high and low halves
+__attribute__((target("avx2")))
+inline void multiplyLanes(__m256i a, __m256i b, __m256i &high, __m256i &low){
+    __m256i even = _mm256_mul_epu32(a, b);
+    __m256i odd = _mm256_mul_epu32(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(b, 32));
+    high = _mm256_blend_epi32(_mm256_srli_epi64(even, 32), odd, 0xAA);
+    low = _mm256_blend_epi32(even, _mm256_slli_epi64(odd, 32), 0xAA);
+}
+
+// Philox4x32::block() on eight counters sharing one key
+__attribute__((target("avx2")))
+inline void philoxLanes(__m256i c[4], uint32_t k0, uint32_t k1){
+    const __m256i m0 = _mm256_set1_epi32((int)Philox4x32::M0);
+    const __m256i m1 = _mm256_set1_epi32((int)Philox4x32::M1);
+    for(int round=0; round<10; round++){
+        __m256i high0, low0, high1, low1;
+        multiplyLanes(c[0], m0, high0, low0);
+        multiplyLanes(c[2], m1, high1, low1);
+        c[0] = _mm256_xor_si256(_mm256_xor_si256(high1, c[1]), _mm256_set1_epi32((int)k0));
+        c[1] = low1;
+        c[2] = _mm256_xor_si256(_mm256_xor_si256(high0, c[3]), _mm256_set1_epi32((int)k1));
+        c[3] = low0;
+        k0 += Philox4x32::W0;
+        k1 += Philox4x32::W1;
+    }
+}
+
+// boundedRandom() of each lane's word, flagging in redo the lanes whose low
+// product is below range: only those can be rejected
+__attribute__((target("avx2")))
+inline __m256i boundedLanes(__m256i words, uint32_t range, int &redo){
+    __m256i high, low;
+    multiplyLanes(words, _mm256_set1_epi32((int)range), high, low);
+    __m256i below = _mm256_cmpeq_epi32(_mm256_min_epu32(low, _mm256_set1_epi32((int)(range - 1))), low);
+    redo |= _mm256_movemask_ps(_mm256_castsi256_ps(below));
+    return high;
+}
+
+// K distinct balls from 1..N and a bonus ball from 1..B (none if B is 0) for
+// streams (seed, purpose, round, firstIndex + lane)
+template<int N, int K, int B>
+__attribute__((target("avx2")))
+void quickPickLanesAvx2(uint64_t seed, uint32_t purpose, uint64_t round, uint64_t firstIndex,
+                        QuickPickLanes<K> &out){
+    const int WORDS = K + (B > 0);
+    const int BLOCKS = (WORDS + 3) / 4;
+    static_assert(BLOCKS <= 2, "a ticket takes at most two Philox blocks");
+
+    uint32_t key[2];
+    uint32_t counter[4];
+    alignas(32) uint32_t index_low[QUICK_PICK_LANES];
+    alignas(32) uint32_t index_high[QUICK_PICK_LANES];
+    for(int l=0; l<QUICK_PICK_LANES; l++){
+        PhiloxStream::start(seed, purpose, round, firstIndex + l, key, counter);
+        index_low[l] = counter[2];
+        index_high[l] = counter[3];
+    }
+
+    __m256i words[BLOCKS * 4];
+    for(int b=0; b<BLOCKS; b++){
+        __m256i c[4] = {_mm256_set1_epi32(b), _mm256_set1_epi32((int)counter[1]),
+                        _mm256_load_si256((const __m256i*)index_low), _mm256_load_si256((const __m256i*)index_high)};
+        philoxLanes(c, key[0], key[1]);
+        for(int w=0; w<4; w++)
+            words[b * 4 + w] = c[w];
+    }
+
+    int redo = 0;
+    const __m256i one = _mm256_set1_epi32(1);
+    __m256i swaps[K];
+    for(int i=0; i<K; i++){
+        swaps[i] = _mm256_add_epi32(boundedLanes(words[i], N - i, redo), _mm256_set1_epi32(i));
+        __m256i position = swaps[i];
+        for(int k=i - 1; k>=0; k--)
+            position = _mm256_blendv_epi8(position, _mm256_set1_epi32(k), _mm256_cmpeq_epi32(position, swaps[k]));
+        _mm256_storeu_si256((__m256i*)out.balls[i], _mm256_add_epi32(position, one));
+    }
+    if constexpr (B > 0)
+        _mm256_storeu_si256((__m256i*)out.balls[K], _mm256_add_epi32(boundedLanes(words[K], B, redo), one));
+    out.redo = (uint32_t)redo;
+}
+
+#endif
+
+#endif
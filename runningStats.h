@@ -0,0 +1,60 @@
+#ifndef RUNNING_STATS_H
+#define RUNNING_STATS_H
+
+#include <cmath>
+
+// z for a two-sided 95% confidence interval
+const double CI_95_Z = 1.959964;
+
+// Count, mean and sum of squared deviations (M2) of a stream of
+// observations. Single values update with Welford's method; whole batches
+// (a draw's worth of tickets, say) merge with Chan et al.'s formula, so the
+// per-ticket work stays a counter increment and nothing is stored.
+struct RunningStats
+{
+    long long count = 0;
+    double mean = 0.0;
+    double m2 = 0.0;
+
+    void add(double value){
+        count++;
+        double delta = value - mean;
+        mean += delta / count;
+        m2 += delta * (value - mean);
+    }
+
+    // Merge a batch of n observations with the given mean and M2
+    void addBatch(long long n, double batchMean, double batchM2){
+        if(n <= 0)
+            return;
+        long long total = count + n;
+        double delta = batchMean - mean;
+        mean += delta * n / total;
+        m2 += batchM2 + delta * delta * ((double)count * n / total);
+        count = total;
+    }
+
+    void add(const RunningStats &other){
+        addBatch(other.count, other.mean, other.m2);
+    }
+
+    double variance() const{
+        return count > 1 ? m2 / (count - 1) : 0.0;
+    }
+
+    // Half the width of the confidence interval on the mean
+    double halfWidth(double z = CI_95_Z) const{
+        return count > 0 ? z * std::sqrt(variance() / count) : INFINITY;
+    }
+};
+
+// Half the width of the (normal approximation) confidence interval on a
+// frequency observed hits times in trials
+inline double frequencyHalfWidth(long long hits, long long trials, double z = CI_95_Z){
+    if(trials <= 0)
+        return INFINITY;
+    double p = (double)hits / trials;
+    return z * std::sqrt(p * (1.0 - p) / trials);
+}
+
+#endif
@@ -0,0 +1,311 @@
+#ifndef SIM_OPTIONS_H
+#define SIM_OPTIONS_H
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <thread>
+#include "money.h"
+
+// How much a batch run prints; each level includes the ones before it
+enum OutputLevel
+{
+    OUTPUT_SUMMARY, // Final totals only
+    OUTPUT_ROUNDS,  // One line per draw plus final totals
+    OUTPUT_WINNERS, // Every winning ticket of every draw too
+    OUTPUT_TICKETS  // Every ticket of every draw too
+};
+
+// Each worker keeps a tally per draw a ticket is entered in
+const long long MAX_DRAWS = 100000;
+
+// Command-line options for running a game without prompts
+struct SimOptions
+{
+    bool batch = false;             // Any option given: run headless
+    long long plays = 1;            // Quick pick tickets per draw
+    bool playsGiven = false;        // --plays was passed
+    long long rounds = 1;           // Number of draws, or of K-draw entries with draws > 1
+    bool roundsGiven = false;       // --rounds was passed
+    long long draws = 1;            // Consecutive draws each ticket is entered in
+    bool doublePlay = false;        // Add Double Play (Powerball only)
+    bool multiplier = false;        // Add Power Play / Megaplier / Xtra
+    bool seeded = false;            // Use seed instead of random_device
+    unsigned long long seed = 0;
+    long long ticketIndex = -1;     // Print only this quick pick (0-based) of ticketRound; -1 = off
+    long long ticketRound = 1;
+    Money jackpot = 0;              // Jackpot in dollars; 0 = fetch current jackpot
+    int threads = 0;                // Worker threads; 0 = one per hardware thread
+    std::string ticketFile;         // Score these fixed tickets instead of quick picks
+    std::string historyFile;        // Replay the tickets against these official draws
+    OutputLevel output = OUTPUT_SUMMARY;
+    bool odds = false;              // Print exact odds and expected value instead of simulating
+    bool importance = false;        // Sample every tier equally and reweight by its exact odds
+    double targetCi = 0.0;          // Stop once the 95% CI on return per $1 is this narrow; 0 = off
+    double tierCi = 0.0;            // ... and each tier's frequency CI is this narrow relative to it
+    long long cacheTtl = 3600;      // Seconds fetched game data is reused; 0 = always fetch
+    std::string dataUrl;            // Fetch game data from here instead of lotteryusa.com
+    std::string baseUrl;            // Fetch lotteryusa.com page paths from this server instead
+    bool refreshAll = false;        // Fetch and cache every game's data, then exit
+    long long connectTimeout = 5;   // Seconds per fetch attempt to connect
+    long long fetchTimeout = 15;    // Seconds per fetch attempt in total
+    long long fetchAttempts = 3;    // Fetch attempts before giving up
+};
+
+inline void printUsage(const char* program, const char* multiplierName){
+    std::cout << "Usage: " << program << " [options]\n\n"
+        "Run without options to play interactively. Any option other than the game\n"
+        "data options runs a headless batch of quick picks and prints aggregate\n"
+        "results only.\n\n"
+        "  --plays N              Quick pick tickets per draw (default 1; not with\n"
+        "                         --tickets, which plays the whole pool)\n"
+        "  --rounds N             Number of draws to simulate, or of K-draw entries\n"
+        "                         with --draws (default 1)\n"
+        "  --draws K              Enter each ticket in K consecutive draws (default 1)\n"
+        "  --multiplier on|off    Add " << multiplierName << " (default off)\n"
+        "  --double-play on|off   Add Double Play, Powerball only (default off)\n"
+        "  --seed N               Seed the random number generator; every ticket and\n"
+        "                         draw of a run depends only on the seed and its\n"
+        "                         position, whatever the thread count\n"
+        "  --ticket-index I       Regenerate only quick pick I (counting from 0) of\n"
+        "                         the run with --seed, and print it against the\n"
+        "                         draws of its round with its winnings (jackpot\n"
+        "                         hits only with --jackpot)\n"
+        "  --round R              Round of --ticket-index (default 1)\n"
+        "  --threads N            Worker threads (default: one per hardware thread)\n"
+        "  --tickets FILE         Play the tickets in FILE every draw instead of quick\n"
+        "                         picks (text, one ticket per line, or binary)\n"
+        "  --history FILE         Replay the --tickets pool against every official draw\n"
+        "                         in FILE (CSV: date, numbers, multiplier, jackpot)\n"
+        "  --jackpot N            Jackpot in dollars instead of fetching it\n"
+        "  --odds                 Print the exact odds and expected value of a ticket\n"
+        "                         instead of simulating, with the Double Play tiers\n"
+        "                         under --double-play on\n"
+        "  --importance           Estimate the return and tier odds by importance\n"
+        "                         sampling: tickets are built to land in each tier\n"
+        "                         equally often and weighted by its exact odds\n"
+        "  --target-ci WIDTH      Play rounds until the 95% confidence interval on the\n"
+        "                         return per $1 is narrower than WIDTH (e.g. 0.05);\n"
+        "                         --rounds is then the most rounds to play\n"
+        "  --tier-ci FRACTION     With --target-ci, also wait until every prize tier\n"
+        "                         but the jackpot has an interval narrower than\n"
+        "                         FRACTION of its observed frequency (e.g. 0.1)\n"
+        "  --output summary|rounds|winners|tickets\n"
+        "                         Print totals only, a line per draw too, and also\n"
+        "                         every winning ticket or every ticket\n"
+        "  --help                 Show this message\n\n"
+        "Game data options:\n"
+        "  --cache-ttl SECONDS    Reuse fetched jackpot data this long (default 3600)\n"
+        "  --no-cache             Always fetch, and do not update the cache\n"
+        "  --data-url URL         Fetch from URL (http://, https:// or file://)\n"
+        "                         instead of lotteryusa.com; LOTTERY_DATA_URL also\n"
+        "                         sets it\n"
+        "  --base-url URL         Fetch the lotteryusa.com page paths from another\n"
+        "                         server; LOTTERY_BASE_URL also sets it\n"
+        "  --refresh-all          Fetch every game's data at once, update the cache\n"
+        "                         and exit\n"
+        "  --connect-timeout SECONDS\n"
+        "                         Give up connecting after this long (default 5)\n"
+        "  --timeout SECONDS      Give up a fetch attempt after this long (default 15)\n"
+        "  --attempts N           Fetch attempts, with backoff between them (default 3)\n\n"
+        "If every attempt fails, the last cached data is used however old it is.\n"
+        "Batch runs can pass --jackpot instead; interactive play asks for it.\n" << std::endl;
+}
+
+// Parse a non-negative integer option value; returns false on bad input
+inline bool parseCount(const char* text, long long &value){
+    char* end;
+    if (text == nullptr || *text == '\0' || *text == '-')
+        return false;
+    errno = 0;
+    value = std::strtoll(text, &end, 10);
+    return *end == '\0' && errno != ERANGE;
+}
+
+// Parse a seed, which may use all 64 bits; returns false on bad input
+inline bool parseSeed(const char* text, unsigned long long &seed){
+    char* end;
+    if (text == nullptr || *text < '0' || *text > '9')
+        return false;
+    errno = 0;
+    seed = std::strtoull(text, &end, 10);
+    return *end == '\0' && errno != ERANGE;
+}
+
+inline bool parseOutputLevel(const char* text, OutputLevel &level){
+    const char* names[] = {"summary", "rounds", "winners", "tickets"};
+    for (int i = 0; i < 4; i++)
+        if (std::strcmp(text, names[i]) == 0){
+            level = (OutputLevel)i;
+            return true;
+        }
+    return false;
+}
+
+// Parse a positive decimal option value; returns false on bad input
+inline bool parsePositive(const char* text, double &value){
+    char* end;
+    if (text == nullptr || *text == '\0')
+        return false;
+    value = std::strtod(text, &end);
+    return *end == '\0' && value > 0.0 && value < 1e300;
+}
+
+// Fill options from argv. Returns false if the program should exit, with
+// exitCode set (0 after --help, 1 after invalid options).
+inline bool parseSimOptions(int argc, char* argv[], const char* multiplierName,
+                            SimOptions &options, int &exitCode){
+    exitCode = 0;
+
+    for(int i=1; i<argc; i++){
+        std::string arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        long long number;
+        double fraction;
+
+        if (arg != "--cache-ttl" && arg != "--no-cache" && arg != "--data-url"
+                && arg != "--base-url" && arg != "--refresh-all" && arg != "--connect-timeout"
+                && arg != "--timeout" && arg != "--attempts")
+            options.batch = true;
+
+        if (arg == "--help" || arg == "-h"){
+            printUsage(argv[0], multiplierName);
+            return false;
+        }
+        else if ((arg == "--plays" || arg == "--rounds" || arg == "--jackpot")
+                && parseCount(value, number)){
+            if (arg == "--plays"){
+                options.plays = number;
+                options.playsGiven = true;
+            }
+            else if (arg == "--rounds"){
+                options.rounds = number;
+                options.roundsGiven = true;
+            }
+            else
+                options.jackpot = number;
+            i++;
+        }
+        else if (arg == "--ticket-index" && parseCount(value, number) && number < (1LL << 56)){
+            options.ticketIndex = number;
+            i++;
+        }
+        else if (arg == "--round" && parseCount(value, number) && number >= 1){
+            options.ticketRound = number;
+            i++;
+        }
+        else if (arg == "--draws" && parseCount(value, number) && number >= 1 && number <= MAX_DRAWS){
+            options.draws = number;
+            i++;
+        }
+        else if (arg == "--double-play" && value != nullptr
+                && (std::strcmp(value, "on") == 0 || std::strcmp(value, "off") == 0)){
+            options.doublePlay = std::strcmp(value, "on") == 0;
+            i++;
+        }
+        else if (arg == "--threads" && parseCount(value, number) && number >= 1 && number <= 4096){
+            options.threads = (int)number;
+            i++;
+        }
+        else if (arg == "--seed" && parseSeed(value, options.seed)){
+            options.seeded = true;
+            i++;
+        }
+        else if ((arg == "--target-ci" || arg == "--tier-ci") && parsePositive(value, fraction)){
+            if (arg == "--target-ci")
+                options.targetCi = fraction;
+            else
+                options.tierCi = fraction;
+            i++;
+        }
+        else if (arg == "--importance"){
+            options.importance = true;
+        }
+        else if (arg == "--odds"){
+            options.odds = true;
+        }
+        else if (arg == "--cache-ttl" && parseCount(value, number)){
+            options.cacheTtl = number;
+            i++;
+        }
+        else if (arg == "--no-cache"){
+            options.cacheTtl = 0;
+        }
+        else if (arg == "--data-url" && value != nullptr){
+            options.dataUrl = value;
+            i++;
+        }
+        else if (arg == "--base-url" && value != nullptr){
+            options.baseUrl = value;
+            i++;
+        }
+        else if (arg == "--refresh-all"){
+            options.refreshAll = true;
+        }
+        else if ((arg == "--connect-timeout" || arg == "--timeout" || arg == "--attempts")
+                && parseCount(value, number) && number >= 1 && number <= 3600){
+            if (arg == "--connect-timeout")
+                options.connectTimeout = number;
+            else if (arg == "--timeout")
+                options.fetchTimeout = number;
+            else
+                options.fetchAttempts = number;
+            i++;
+        }
+        else if (arg == "--tickets" && value != nullptr){
+            options.ticketFile = value;
+            i++;
+        }
+        else if (arg == "--history" && value != nullptr){
+            options.historyFile = value;
+            i++;
+        }
+        else if (arg == "--multiplier" && value != nullptr
+                && (std::strcmp(value, "on") == 0 || std::strcmp(value, "off") == 0)){
+            options.multiplier = std::strcmp(value, "on") == 0;
+            i++;
+        }
+        else if (arg == "--output" && value != nullptr && parseOutputLevel(value, options.output)){
+            i++;
+        }
+        else{
+            std::cerr << "Invalid option or value: " << arg << "\n" << std::endl;
+            printUsage(argv[0], multiplierName);
+            exitCode = 1;
+            return false;
+        }
+    }
+
+    // A converging run without tickets would never have a sample to stop on
+    if (options.targetCi > 0.0 && options.plays == 0 && options.ticketFile.empty()){
+        std::cerr << "--target-ci needs at least one ticket per draw" << std::endl;
+        exitCode = 1;
+        return false;
+    }
+    // Converging runs stop by themselves unless given a limit
+    if (options.targetCi > 0.0 && !options.roundsGiven)
+        options.rounds = std::numeric_limits<long long>::max();
+    return true;
+}
+
+// The --seed value, or a fresh one from random_device. Batch runs print the
+// seed they used so any run can be repeated.
+inline unsigned long long resolveSeed(const SimOptions &options){
+    if (options.seeded)
+        return options.seed;
+    std::random_device rd;
+    return ((unsigned long long)rd() << 32) | rd();
+}
+
+inline int resolveThreads(const SimOptions &options){
+    if (options.threads > 0)
+        return options.threads;
+    unsigned hardware = std::thread::hardware_concurrency();
+    return hardware > 0 ? (int)hardware : 1;
+}
+
+#endif
@@ -0,0 +1,154 @@
+#ifndef TEXT_UTILS_H
+#define TEXT_UTILS_H
+
+#include <cctype>
+#include <cmath>
+#include <cstring>
+#include <string>
+#include "money.h"
+
+// Function to remove leading and trailing spaces from a string
+inline void removeLeadingTrailingSpaces(std::string &str) {
+    if (str.empty())
+        return;
+
+    size_t start = 0;
+    size_t end = str.length() - 1;
+
+    // Remove leading spaces
+    while (start < str.length() && std::isspace(str[start])) {
+        start++;
+    }
+
+    // Remove trailing spaces
+    while (end > start && std::isspace(str[end])) {
+        end--;
+    }
+
+    // Erase leading and trailing spaces from the string
+    str = str.substr(start, end - start + 1);
+
+    // Remove any newlines from the string
+    int n=0;
+    for(int i=0;i<str.length();i++){
+        if (str[i]=='\n'){
+            str[i] = ' '; // replace newline with space
+        }
+        else{
+            str[i-n]=str[i];
+        }
+    }
+    str.resize(str.length()-n);
+
+    // Remove any tabs from the string
+    n=0;
+    for(int i=0;i<str.length();i++){
+        if(str[i]=='\t'){
+            n++;
+        }
+        else{
+            str[i-n]=str[i];
+        }
+    }
+    str.resize(str.length()-n);
+}
+
+// Longest text writeWithCommas() produces, plus a terminating nul:
+// "-9,223,372,036,854,775,808"
+const int COMMA_TEXT_SIZE = 27;
+
+// Write value with thousands commas to text, which must have room for
+// COMMA_TEXT_SIZE characters; returns the length, not counting the nul.
+// Allocates nothing, so it is safe to call for every ticket printed.
+inline int writeWithCommas(char* text, long long value){
+    char digits[COMMA_TEXT_SIZE];
+    unsigned long long magnitude = value < 0 ? 0ULL - (unsigned long long)value : (unsigned long long)value;
+    int count = 0;
+    do{
+        if(count % 4 == 3)
+            digits[count++] = ',';
+        digits[count++] = (char)('0' + magnitude % 10);
+        magnitude /= 10;
+    }while(magnitude > 0);
+
+    int length = 0;
+    if(value < 0)
+        text[length++] = '-';
+    while(count > 0)
+        text[length++] = digits[--count];
+    text[length] = '\0';
+    return length;
+}
+
+inline std::string formatWithCommas(long long value){
+    char text[COMMA_TEXT_SIZE];
+    return std::string(text, writeWithCommas(text, value));
+}
+
+// Read the first number in [p, end), skipping any text before it: digits
+// with optional thousands commas and a decimal part. Returns false if there is
+// none; grouped is set if the number had thousands commas. Hand-written so
+// parsing jackpots in bulk (history files) allocates nothing.
+inline bool parseFirstNumber(const char* p, const char* end, double &value, bool &grouped){
+    while (p < end && (*p < '0' || *p > '9'))
+        p++;
+    if (p == end)
+        return false;
+
+    long long whole = 0;
+    grouped = false;
+    for (; p < end; p++) {
+        if (*p >= '0' && *p <= '9') {
+            if (whole < 1000000000000000000LL / 10)
+                whole = whole * 10 + (*p - '0');
+        }
+        else if (*p == ',' && p + 3 < end && p[1] >= '0' && p[1] <= '9' && p[2] >= '0' && p[2] <= '9'
+                && p[3] >= '0' && p[3] <= '9' && (p + 4 == end || p[4] < '0' || p[4] > '9'))
+            grouped = true;     // Thousands separator: exactly three digits follow
+        else
+            break;
+    }
+
+    double fraction = 0.0, scale = 1.0;
+    if (p + 1 < end && *p == '.' && p[1] >= '0' && p[1] <= '9')
+        for (p++; p < end && *p >= '0' && *p <= '9'; p++) {
+            scale /= 10;
+            fraction += (*p - '0') * scale;
+        }
+    value = whole + fraction;
+    return true;
+}
+
+// Whether word appears in [p, end)
+inline bool containsWord(const char* p, const char* end, const char* word){
+    size_t length = std::strlen(word);
+    for (; p + length <= end; p++)
+        if (std::memcmp(p, word, length) == 0)
+            return true;
+    return false;
+}
+
+// Convert jackpot text (e.g. "$1.2 Billion", "$350 Million", "$415,000") to
+// dollars. Rounded rather than truncated, so "$1.2 Billion" is $1,200,000,000.
+// A number with thousands commas is in dollars; a bare number without a
+// Billion/Million word is counted in unit dollars.
+inline Money jackpotFromText(const char* text, const char* end, int unit){
+    double amount;
+    bool grouped;
+    if (!parseFirstNumber(text, end, amount, grouped))
+        return 0;
+    if (containsWord(text, end, "Billion"))
+        return std::llround(amount * 1000000000);
+    else if (containsWord(text, end, "Million"))
+        return std::llround(amount * 1000000);
+    else if (grouped)
+        return std::llround(amount);
+    else
+        return std::llround(amount * unit);
+}
+
+inline Money jackpotFromString(const std::string &jackpot_string, int unit){
+    return jackpotFromText(jackpot_string.data(), jackpot_string.data() + jackpot_string.size(), unit);
+}
+
+#endif
@@ -0,0 +1,126 @@
+#ifndef TICKET_BATCH_H
+#define TICKET_BATCH_H
+
+#include <cstdint>
+#include <cstring>
+#include "ballMask.h"
+#include "cpuFeatures.h"
+#include "prizeTable.h"
+
+// A block of tickets stored by column: each 64-bit word of the white ball
+// masks in its own aligned array, and the bonus balls in another. Scoring
+// then reads whole columns with vector loads, and on CPUs with AVX2 scores
+// eight tickets per step without a branch: AND with the winning mask,
+// popcount through a nibble lookup table (pshufb), add the bonus match and
+// write each ticket's tierIndex(). Other CPUs use a scalar loop over the
+// same columns.
+template<int MaxBall, int Capacity>
+struct TicketBatch
+{
+    static const int WORDS = BallMask<MaxBall>::WORDS;
+    static const int LANES = 8;                 // Tickets per AVX2 step
+    static_assert(Capacity % LANES == 0, "batch capacity must be a multiple of 8 tickets");
+
+    alignas(32) uint64_t white[WORDS][Capacity];
+    alignas(32) int32_t bonus[Capacity];
+    int count = 0;
+
+    // Fill the batch from count tickets (each with a BallMask<MaxBall> white
+    // and an int bonus, as in lotteryEngine.h), clearing the lanes after the
+    // last ticket up to a whole step
+    template<class Ticket>
+    void assign(const Ticket* tickets, int n){
+        count = n;
+        for(int w=0; w<WORDS; w++)
+            for(int j=0; j<n; j++)
+                white[w][j] = tickets[j].white.words[w];
+        for(int j=0; j<n; j++)
+            bonus[j] = tickets[j].bonus;
+
+        int padded = (n + LANES - 1) / LANES * LANES;
+        for(int w=0; w<WORDS; w++)
+            std::memset(&white[w][n], 0, (padded - n) * sizeof(uint64_t));
+        std::memset(&bonus[n], 0, (padded - n) * sizeof(int32_t));
+    }
+};
+
+template<int MaxBall, int Capacity>
+void scoreBatchScalar(const TicketBatch<MaxBall, Capacity> &batch, const BallMask<MaxBall> &winning,
+                      int winningBonus, bool hasBonus, uint8_t* tiers){
+    for(int j=0; j<batch.count; j++){
+        int matches = 0;
+        for(int w=0; w<BallMask<MaxBall>::WORDS; w++)
+            matches += __builtin_popcountll(batch.white[w][j] & winning.words[w]);
+        tiers[j] = (uint8_t)tierIndex(matches, hasBonus && batch.bonus[j] == winningBonus);
+    }
+}
+
+#ifdef SIMD_AVX2
+
+// Bits set in each byte of v
+__attribute__((target("avx2")))
+inline __m256i popcountBytes(__m256i v){
+    const __m256i table = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                           0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+    const __m256i nibble = _mm256_set1_epi8(0x0f);
+    return _mm256_add_epi8(_mm256_shuffle_epi8(table, _mm256_and_si256(v, nibble)),
+                           _mm256_shuffle_epi8(table, _mm256_and_si256(_mm256_srli_epi16(v, 4), nibble)));
+}
+
+template<int MaxBall, int Capacity>
+__attribute__((target("avx2")))
+void scoreBatchAvx2(const TicketBatch<MaxBall, Capacity> &batch, const BallMask<MaxBall> &winning,
+                    int winningBonus, bool hasBonus, uint8_t* tiers){
+    const int WORDS = BallMask<MaxBall>::WORDS;
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i bonus = _mm256_set1_epi32(winningBonus);
+    const __m256i in_order = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+    // Low byte of each 32-bit lane to the front of its 128-bit half
+    const __m256i low_bytes = _mm256_setr_epi8(0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                                               0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+    __m256i masks[WORDS];
+    for(int w=0; w<WORDS; w++)
+        masks[w] = _mm256_set1_epi64x((long long)winning.words[w]);
+
+    for(int j=0; j<batch.count; j+=8){
+        // Matches of tickets j..j+3 and j+4..j+7, as byte counts summed into 64-bit lanes
+        __m256i bytes0 = zero, bytes1 = zero;
+        for(int w=0; w<WORDS; w++){
+            bytes0 = _mm256_add_epi8(bytes0, popcountBytes(_mm256_and_si256(
+                         _mm256_load_si256((const __m256i*)&batch.white[w][j]), masks[w])));
+            bytes1 = _mm256_add_epi8(bytes1, popcountBytes(_mm256_and_si256(
+                         _mm256_load_si256((const __m256i*)&batch.white[w][j + 4]), masks[w])));
+        }
+        __m256i matches = _mm256_or_si256(_mm256_sad_epu8(bytes0, zero),
+                                          _mm256_slli_epi64(_mm256_sad_epu8(bytes1, zero), 32));
+        matches = _mm256_permutevar8x32_epi32(matches, in_order);
+
+        // tierIndex(): matches * 2, plus 1 (minus the all-ones of a compare) for the bonus
+        __m256i tier = _mm256_add_epi32(matches, matches);
+        if(hasBonus)
+            tier = _mm256_sub_epi32(tier, _mm256_cmpeq_epi32(
+                       _mm256_load_si256((const __m256i*)&batch.bonus[j]), bonus));
+
+        tier = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(tier, low_bytes), _mm256_setr_epi32(0, 4, 0, 0, 0, 0, 0, 0));
+        _mm_storel_epi64((__m128i*)&tiers[j], _mm256_castsi256_si128(tier));
+    }
+}
+
+#endif
+
+// Write the tierIndex() of every ticket in batch against the winning numbers
+// to tiers, which must hold the batch's count rounded up to a multiple of 8.
+// hasBonus is false for games without a bonus ball.
+template<int MaxBall, int Capacity>
+void scoreBatch(const TicketBatch<MaxBall, Capacity> &batch, const BallMask<MaxBall> &winning,
+                int winningBonus, bool hasBonus, uint8_t* tiers){
+#ifdef SIMD_AVX2
+    if(cpuHasAvx2()){
+        scoreBatchAvx2(batch, winning, winningBonus, hasBonus, tiers);
+        return;
+    }
+#endif
+    scoreBatchScalar(batch, winning, winningBonus, hasBonus, tiers);
+}
+
+#endif
@@ -0,0 +1,301 @@
+#ifndef TICKET_FILE_H
+#define TICKET_FILE_H
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Ticket files hold a pool of fixed tickets for one game, in either format:
+//
+// Text: one ticket per line, the 5 white numbers followed by the bonus ball
+// (Powerball/Megaball; none for Jersey Cash 5), separated by spaces, tabs or
+// commas. Blank lines and lines starting with # are ignored.
+//
+// Binary: a 16-byte header then one record per ticket of one byte per ball.
+//   bytes 0-3   "LTKT"
+//   byte  4     version (1)
+//   byte  5     balls per ticket (6 with a bonus ball, 5 without)
+//   byte  6     highest white number of the game
+//   byte  7     highest bonus number of the game (0 if none)
+//   bytes 8-15  number of tickets, little-endian
+
+const char TICKET_FILE_MAGIC[4] = {'L', 'T', 'K', 'T'};
+const size_t TICKET_FILE_HEADER = 16;
+
+// Valid numbers for a game's tickets
+struct TicketRules
+{
+    int whiteMax;   // White numbers are 1..whiteMax
+    int bonusMax;   // Bonus ball is 1..bonusMax; 0 if the game has none
+
+    int ballsPerTicket() const{
+        return bonusMax > 0 ? 6 : 5;
+    }
+};
+
+// Check a ticket's numbers; returns nullptr if valid, otherwise the problem
+inline const char* validateTicketNumbers(const int balls[6], const TicketRules &rules){
+    uint64_t seen[2] = {0, 0};
+    for(int j=0; j<5; j++){
+        if(balls[j] < 1 || balls[j] > rules.whiteMax)
+            return "white number out of range";
+        uint64_t bit = (uint64_t)1 << (balls[j] & 63);
+        if(seen[balls[j] >> 6] & bit)
+            return "number already chosen";
+        seen[balls[j] >> 6] |= bit;
+    }
+    if(rules.bonusMax > 0 && (balls[5] < 1 || balls[5] > rules.bonusMax))
+        return "bonus number out of range";
+    return nullptr;
+}
+
+// Read-only memory mapping of a whole file
+class MappedFile
+{
+public:
+    MappedFile() : data(nullptr), length(0){}
+
+    ~MappedFile(){
+        if(data != nullptr && length > 0)
+            munmap((void*)data, length);
+    }
+
+    bool open(const std::string &path, std::string &error){
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if(fd < 0){
+            error = "cannot open " + path + ": " + std::strerror(errno);
+            return false;
+        }
+        struct stat info;
+        if(fstat(fd, &info) != 0){
+            error = "cannot read " + path + ": " + std::strerror(errno);
+            close(fd);
+            return false;
+        }
+        length = (size_t)info.st_size;
+        if(length > 0){
+            void* mapping = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+            if(mapping == MAP_FAILED){
+                error = "cannot map " + path + ": " + std::strerror(errno);
+                close(fd);
+                length = 0;
+                return false;
+            }
+            madvise(mapping, length, MADV_SEQUENTIAL);
+            data = (const char*)mapping;
+        }
+        close(fd);
+        return true;
+    }
+
+    const char* begin() const{ return data; }
+    size_t size() const{ return length; }
+
+private:
+    MappedFile(const MappedFile&);
+    MappedFile& operator=(const MappedFile&);
+
+    const char* data;
+    size_t length;
+};
+
+// Start of the line after the newline at or after p, or end
+inline const char* nextLineStart(const char* p, const char* end){
+    const char* newline = (const char*)std::memchr(p, '\n', end - p);
+    return newline != nullptr ? newline + 1 : end;
+}
+
+// What one parser thread produced from its slice of the file
+template<class Ticket>
+struct TicketSlice
+{
+    std::vector<Ticket> tickets;
+    long long lines = 0;        // Lines consumed, to number errors globally
+    long long errorLine = 0;    // 1-based line within the slice; 0 = no error
+    std::string error;
+};
+
+// Parse whole lines in [p, end) into slice; stops at the first invalid line
+template<class Ticket, class MakeTicket>
+void parseTicketLines(const char* p, const char* end, const TicketRules &rules,
+                      MakeTicket makeTicket, TicketSlice<Ticket> &slice){
+    const int expected = rules.ballsPerTicket();
+
+    while(p < end){
+        int balls[6] = {0, 0, 0, 0, 0, 0};
+        int count = 0;
+        bool comment = false;
+        bool bad = false;
+        slice.lines++;
+
+        while(p < end && *p != '\n'){
+            char c = *p;
+            if(c >= '0' && c <= '9'){
+                int value = 0;
+                for(; p < end && *p >= '0' && *p <= '9'; p++)
+                    if(value < 1000)    // Any larger number is out of range anyway
+                        value = value * 10 + (*p - '0');
+                if(count < 6)
+                    balls[count] = value;
+                count++;
+            }
+            else if(c == ' ' || c == '\t' || c == ',' || c == '\r')
+                p++;
+            else if(c == '#' && count == 0){
+                comment = true;
+                while(p < end && *p != '\n')
+                    p++;
+            }
+            else{
+                bad = true;
+                p++;
+            }
+        }
+        if(p < end)
+            p++;    // Newline
+
+        if(comment || (count == 0 && !bad))
+            continue;
+
+        const char* problem = nullptr;
+        if(bad)
+            problem = "unexpected character";
+        else if(count != expected)
+            problem = expected == 6 ? "expected 5 numbers and a bonus number" : "expected 5 numbers";
+        else
+            problem = validateTicketNumbers(balls, rules);
+
+        if(problem != nullptr){
+            slice.errorLine = slice.lines;
+            slice.error = problem;
+            return;
+        }
+        slice.tickets.push_back(makeTicket(balls));
+    }
+}
+
+// Decode binary records [first, first + count) into slice
+template<class Ticket, class MakeTicket>
+void parseTicketRecords(const unsigned char* records, long long first, long long count,
+                        const TicketRules &rules, MakeTicket makeTicket, TicketSlice<Ticket> &slice){
+    const int width = rules.ballsPerTicket();
+    slice.tickets.reserve(count);
+
+    for(long long i=first; i<first + count; i++){
+        const unsigned char* record = records + i * width;
+        int balls[6] = {record[0], record[1], record[2], record[3], record[4], width == 6 ? record[5] : 0};
+        const char* problem = validateTicketNumbers(balls, rules);
+        if(problem != nullptr){
+            slice.errorLine = i - first + 1;
+            slice.error = problem;
+            return;
+        }
+        slice.tickets.push_back(makeTicket(balls));
+    }
+    slice.lines = count;
+}
+
+// Load every ticket in a text or binary ticket file, parsing slices of the
+// mapped file on up to threads threads. makeTicket(const int balls[6]) builds
+// a game ticket from validated numbers. Returns false with error set (naming
+// the offending line or record) if the file cannot be read or holds an invalid
+// ticket.
+template<class Ticket, class MakeTicket>
+bool loadTicketFile(const std::string &path, const TicketRules &rules, int threads,
+                    MakeTicket makeTicket, std::vector<Ticket> &tickets, std::string &error){
+    MappedFile file;
+    if(!file.open(path, error))
+        return false;
+
+    const char* data = file.begin();
+    const size_t size = file.size();
+    const bool binary = size >= TICKET_FILE_HEADER && std::memcmp(data, TICKET_FILE_MAGIC, 4) == 0;
+    const char* unit = binary ? "record " : "line ";
+    long long records = 0;
+
+    if(binary){
+        const unsigned char* header = (const unsigned char*)data;
+        uint64_t count = 0;
+        for(int b=7; b>=0; b--)
+            count = (count << 8) | header[8 + b];
+
+        if(header[4] != 1 || header[5] != rules.ballsPerTicket()
+                || header[6] != rules.whiteMax || header[7] != rules.bonusMax){
+            error = path + ": binary ticket file is for a different game or version";
+            return false;
+        }
+        if(count > (size - TICKET_FILE_HEADER) / header[5]){
+            error = path + ": binary ticket file is truncated";
+            return false;
+        }
+        records = (long long)count;
+    }
+
+    // Small files are not worth the threads
+    const size_t MIN_BYTES_PER_THREAD = 1 << 20;
+    size_t useful = size / MIN_BYTES_PER_THREAD + 1;
+    if(threads < 1)
+        threads = 1;
+    if((size_t)threads > useful)
+        threads = (int)useful;
+
+    std::vector<TicketSlice<Ticket> > slices(threads);
+    std::vector<std::thread> workers;
+
+    for(int t=0; t<threads; t++){
+        if(binary){
+            long long share = records / threads;
+            long long extra = records % threads;
+            long long first = t * share + (t < extra ? t : extra);
+            long long count = share + (t < extra ? 1 : 0);
+            const unsigned char* body = (const unsigned char*)data + TICKET_FILE_HEADER;
+            workers.emplace_back([=, &rules, &slices](){
+                parseTicketRecords(body, first, count, rules, makeTicket, slices[t]);
+            });
+        }
+        else{
+            // Slice boundaries move forward to the start of the next line
+            const char* end = data + size;
+            const char* from = t == 0 ? data : nextLineStart(data + size / threads * t - 1, end);
+            const char* to = t == threads - 1 ? end : nextLineStart(data + size / threads * (t + 1) - 1, end);
+            workers.emplace_back([=, &rules, &slices](){
+                if(from < to)
+                    parseTicketLines(from, to, rules, makeTicket, slices[t]);
+            });
+        }
+    }
+    for(size_t t=0; t<workers.size(); t++)
+        workers[t].join();
+
+    size_t total = 0;
+    long long lineBase = 0;
+    for(int t=0; t<threads; t++){
+        if(slices[t].errorLine > 0){
+            error = path + ": " + unit + std::to_string(lineBase + slices[t].errorLine) + ": " + slices[t].error;
+            return false;
+        }
+        lineBase += slices[t].lines;
+        total += slices[t].tickets.size();
+    }
+
+    if(threads == 1){
+        tickets.swap(slices[0].tickets);
+        return true;
+    }
+    tickets.clear();
+    tickets.reserve(total);
+    for(int t=0; t<threads; t++){
+        tickets.insert(tickets.end(), slices[t].tickets.begin(), slices[t].tickets.end());
+        std::vector<Ticket>().swap(slices[t].tickets);
+    }
+    return true;
+}
+
+#endif
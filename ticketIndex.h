@@ -0,0 +1,96 @@
+#ifndef TICKET_INDEX_H
+#define TICKET_INDEX_H
+
+#include <cstdint>
+#include <vector>
+#include "ballMask.h"
+#include "parallelSim.h"
+
+// Inverted index over a fixed pool of tickets: for every ball number, the ids
+// of the tickets holding it, stored as one array of posting lists (CSR). A
+// draw is scored by walking only the posting lists of the drawn numbers, so
+// each draw touches the ~40% of tickets that share a number with it instead
+// of all of them; tickets matching nothing are counted by subtraction.
+template<int WhitePool, int BonusPool>
+class TicketIndex
+{
+public:
+    // Index count tickets; Ticket has a BallMask<WhitePool> white and an int
+    // bonus, as in lotteryEngine.h
+    template<class Ticket>
+    void build(const Ticket* pool, uint32_t count){
+        tickets = count;
+        buildPostings(pool, whiteStart, whiteIds, WhitePool, [](const Ticket &ticket, auto add){
+            forEachBall(ticket.white, add);
+        });
+        if(BonusPool > 0)
+            buildPostings(pool, bonusStart, bonusIds, BonusPool, [](const Ticket &ticket, auto add){
+                add(ticket.bonus);
+            });
+        matches.assign(count, 0);
+        // One spare slot: every posting writes touched[touched_count] before
+        // knowing whether its ticket is new, so once all count tickets are
+        // listed the next posting writes at touched[count]
+        touched.resize(count + 1);
+    }
+
+    // Add the hits of every indexed ticket against the winning numbers to
+    // tally. Not thread-safe: the index keeps scratch space per draw.
+    void score(const BallMask<WhitePool> &white, int bonus, SimTally &tally){
+        uint32_t touched_count = 0;
+
+        // Count each ticket's white matches, listing a ticket the first time
+        // it is seen (without a branch: the slot is overwritten otherwise)
+        forEachBall(white, [&](int ball){
+            for(uint32_t k=whiteStart[ball]; k<whiteStart[ball + 1]; k++){
+                uint32_t id = whiteIds[k];
+                touched[touched_count] = id;
+                touched_count += matches[id] == 0;
+                matches[id]++;
+            }
+        });
+        if(BonusPool > 0 && bonus >= 1 && bonus <= BonusPool)
+            for(uint32_t k=bonusStart[bonus]; k<bonusStart[bonus + 1]; k++){
+                uint32_t id = bonusIds[k];
+                touched[touched_count] = id;
+                touched_count += matches[id] == 0;
+                matches[id] |= BONUS_MATCHED;
+            }
+
+        for(uint32_t k=0; k<touched_count; k++){
+            uint8_t m = matches[touched[k]];
+            tally.hits[m & ~BONUS_MATCHED][m >> 3]++;
+            matches[touched[k]] = 0;
+        }
+        tally.hits[0][0] += tickets - touched_count;
+        tally.tickets += tickets;
+    }
+
+private:
+    static const uint8_t BONUS_MATCHED = 8;   // Flag in matches[]; white matches use bits 0-2
+
+    // Counting sort of ticket ids by ball: start[ball]..start[ball + 1] - 1 are
+    // the positions in ids of the tickets holding ball
+    template<class Ticket, class ForEach>
+    void buildPostings(const Ticket* pool, std::vector<uint32_t> &start, std::vector<uint32_t> &ids,
+                       int balls, ForEach forEach){
+        start.assign(balls + 2, 0);
+        for(uint32_t id=0; id<tickets; id++)
+            forEach(pool[id], [&](int ball){ start[ball + 1]++; });
+        for(int ball=1; ball<=balls + 1; ball++)
+            start[ball] += start[ball - 1];
+
+        std::vector<uint32_t> next(start.begin(), start.end() - 1);
+        ids.resize(start[balls + 1]);
+        for(uint32_t id=0; id<tickets; id++)
+            forEach(pool[id], [&](int ball){ ids[next[ball]++] = id; });
+    }
+
+    uint32_t tickets = 0;
+    std::vector<uint32_t> whiteStart, whiteIds;
+    std::vector<uint32_t> bonusStart, bonusIds;
+    std::vector<uint8_t> matches;       // Scratch: white matches | BONUS_MATCHED
+    std::vector<uint32_t> touched;      // Scratch: tickets with a nonzero entry in matches
+};
+
+#endif
@@ -0,0 +1,51 @@
+#ifndef TICKET_STORE_H
+#define TICKET_STORE_H
+
+#include <cstddef>
+#include <vector>
+
+// Tickets held before scoring. Enough for interactive play while keeping a
+// pool of tens of millions of tickets to a few hundred kilobytes.
+const size_t DEFAULT_CHUNK_TICKETS = 4096;
+
+// Heap-backed buffer of entered tickets, scored one chunk at a time as the
+// chunk fills, so memory stays bounded however many tickets are played.
+template<class Ticket>
+class TicketStore
+{
+public:
+    explicit TicketStore(size_t capacity = DEFAULT_CHUNK_TICKETS)
+        : capacity(capacity > 0 ? capacity : 1), flushed(0){
+        tickets.reserve(this->capacity);
+    }
+
+    void add(const Ticket &ticket){
+        tickets.push_back(ticket);
+    }
+
+    bool full() const{
+        return tickets.size() >= capacity;
+    }
+
+    // Tickets already passed to flush
+    size_t scored() const{
+        return flushed;
+    }
+
+    // Call score(ticket) for each buffered ticket in entry order, then empty
+    // the buffer for the next chunk
+    template<class Score>
+    void flush(Score score){
+        for(size_t i=0; i<tickets.size(); i++)
+            score(tickets[i]);
+        flushed += tickets.size();
+        tickets.clear();
+    }
+
+private:
+    std::vector<Ticket> tickets;
+    size_t capacity;
+    size_t flushed;
+};
+
+#endif
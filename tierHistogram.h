@@ -0,0 +1,115 @@
+#ifndef TIER_HISTOGRAM_H
+#define TIER_HISTOGRAM_H
+
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include "gameOdds.h"
+#include "parallelSim.h"
+#include "prizeTable.h"
+#include "textUtils.h"
+
+// Hits per [white matches][bonus matched] over a whole run, kept separately
+// for each multiplier drawn. Draw tallies are added once per draw, so the
+// per-ticket work stays the SimTally counter increment. Histograms from
+// separate runs or threads merge with add().
+template<class Game>
+struct TierHistogram
+{
+    static_assert(Game::picks <= 5, "SimTally counts at most 5 white matches");
+
+    static constexpr int MULTIPLIERS = sizeof(Game::multipliers) / sizeof(Game::multipliers[0]);
+    static constexpr int SLOTS = MULTIPLIERS + 1;   // Slot 0: played without the multiplier
+
+    long long draws[SLOTS] = {};
+    long long tickets[SLOTS] = {};
+    long long hits[SLOTS][Game::picks + 1][2] = {};
+
+    static int slot(int multiplier){
+        for(int i=0; i<MULTIPLIERS; i++)
+            if(Game::multipliers[i] == multiplier)
+                return i + 1;
+        return 0;
+    }
+
+    void addDraw(int multiplier, const SimTally &draw){
+        int s = slot(multiplier);
+        draws[s]++;
+        tickets[s] += draw.tickets;
+        for(int white=0; white<=Game::picks; white++)
+            for(int bonus=0; bonus<2; bonus++)
+                hits[s][white][bonus] += draw.hits[white][bonus];
+    }
+
+    void add(const TierHistogram &other){
+        for(int s=0; s<SLOTS; s++){
+            draws[s] += other.draws[s];
+            tickets[s] += other.tickets[s];
+            for(int white=0; white<=Game::picks; white++)
+                for(int bonus=0; bonus<2; bonus++)
+                    hits[s][white][bonus] += other.hits[s][white][bonus];
+        }
+    }
+
+    long long totalTickets() const{
+        long long total = 0;
+        for(int s=0; s<SLOTS; s++)
+            total += tickets[s];
+        return total;
+    }
+
+    long long totalHits(int matching_white, bool matchesBonus) const{
+        long long total = 0;
+        for(int s=0; s<SLOTS; s++)
+            total += hits[s][matching_white][matchesBonus];
+        return total;
+    }
+};
+
+// Print one row per prize tier: base prize, hits (split by multiplier when
+// any draw had one, with a column per multiplier drawn), and observed against
+// theoretical odds
+template<class Game>
+void printTierTable(const TierHistogram<Game> &histogram, std::ostream &out){
+    bool split = false;
+    for(int s=1; s<TierHistogram<Game>::SLOTS; s++)
+        if(histogram.draws[s] > 0)
+            split = true;
+    const long long tickets = histogram.totalTickets();
+
+    out << std::left << std::setw(16) << "Tier" << std::right << std::setw(18) << "Prize"
+        << std::setw(14) << "Hits";
+    if(split){
+        if(histogram.draws[0] > 0)
+            out << std::setw(12) << "Without";
+        for(int i=0; i<TierHistogram<Game>::MULTIPLIERS; i++)
+            if(histogram.draws[i + 1] > 0)
+                out << std::setw(12) << "x" + std::to_string(Game::multipliers[i]);
+    }
+    out << std::setw(20) << "Observed" << std::setw(20) << "Theoretical" << "\n";
+
+    for(int white=Game::picks; white>=0; white--)
+        for(int bonus=1; bonus>=0; bonus--){
+            if(!isPrizeTier<Game>(white, bonus))
+                continue;
+            const PrizeRule &rule = Game::prizes[white][bonus];
+            std::string tier = std::to_string(white);
+            if(bonus)
+                tier += std::string(" + ") + Game::bonusName;
+            std::string prize = rule.amount == JACKPOT ? "Jackpot"
+                : rule.amount == 0 ? "(with " + std::string(Game::multiplierName) + ")"
+                : "$" + formatWithCommas(rule.amount);
+            long long hits = histogram.totalHits(white, bonus);
+
+            out << std::left << std::setw(16) << tier << std::right << std::setw(18) << prize
+                << std::setw(14) << formatWithCommas(hits);
+            if(split)
+                for(int s=0; s<TierHistogram<Game>::SLOTS; s++)
+                    if(histogram.draws[s] > 0)
+                        out << std::setw(12) << formatWithCommas(histogram.hits[s][white][bonus]);
+            out << std::setw(20) << formatOdds(tickets > 0 ? (double)hits / tickets : 0.0)
+                << std::setw(20) << formatOdds(tierProbability<Game>(white, bonus)) << "\n";
+        }
+}
+
+#endif